@@ -54,6 +54,11 @@ public abstract class RuntimeTest extends TestBase {
     return false;
   }
 
+  /** Whether to enable {@link #runBenchmarkTests()}. */
+  protected boolean supportsBenchmarks() {
+    return false;
+  }
+
   @Test
   public void runBasicTests() {
     runTestsForTargets(
@@ -228,6 +233,23 @@ public abstract class RuntimeTest extends TestBase {
         false);
   }
 
+  /**
+   * Run the performance benchmarks if the target provides any. Each benchmark checks its own
+   * timing against a threshold and exits with an error code on violation, so a regression in the
+   * generated code or the runtime fails this test.
+   */
+  @Test
+  public void runBenchmarkTests() {
+    Assumptions.assumeTrue(supportsBenchmarks(), Message.NO_BENCHMARK_SUPPORT);
+    runTestsForTargets(
+        Message.DESC_BENCHMARK,
+        TestCategory.BENCHMARK::equals,
+        Transformers::noChanges,
+        Configurators::noChanges,
+        TestLevel.EXECUTION,
+        false);
+  }
+
   /** Given a test category, return true if it is compatible with single-threaded execution. */
   public static boolean compatibleWithThreadingOff(TestCategory category) {
 
@@ -29,6 +29,11 @@ public class CppTest extends RuntimeTest {
     return true;
   }
 
+  @Override
+  protected boolean supportsBenchmarks() {
+    return true;
+  }
+
   @Test
   @Override
   public void runBasicTests() {
@@ -59,6 +64,12 @@ public class CppTest extends RuntimeTest {
     super.runFederatedTests();
   }
 
+  @Test
+  @Override
+  public void runBenchmarkTests() {
+    super.runBenchmarkTests();
+  }
+
   @Test
   public void runRos2Tests() {}
 }
@@ -0,0 +1,23 @@
+package org.lflang.target.property;
+
+/**
+ * If true, generate a benchmark runner instead of the production main() function.
+ *
+ * <p>This option is currently only used for C++. The benchmark main runs the reactor program
+ * repeatedly (with configurable warmup and measured iterations), records assembly and execution
+ * latencies in histograms, and reports the results as JSON on stdout or to a file.
+ */
+public final class BenchmarkProperty extends BooleanProperty {
+
+  /** Singleton target property instance. */
+  public static final BenchmarkProperty INSTANCE = new BenchmarkProperty();
+
+  private BenchmarkProperty() {
+    super();
+  }
+
+  @Override
+  public String name() {
+    return "benchmark";
+  }
+}
@@ -0,0 +1,26 @@
+package org.lflang.target.property;
+
+/**
+ * If true, generate state checkpoint and restore support for all reactors.
+ *
+ * <p>This option is currently only used for C++. Every reactor gains methods that save and restore
+ * its state variables (and those of all contained reactors) through a binary snapshot file, and
+ * the generated main offers {@code --checkpoint-to} to write a snapshot after execution finishes
+ * and {@code --restore-from} to resume from one before execution starts. Snapshots are tied to the
+ * binary that produced them: state is written in declaration order without any schema. State
+ * variables must be trivially copyable, {@code std::string}, or {@code std::vector} of such types.
+ */
+public final class CheckpointingProperty extends BooleanProperty {
+
+  /** Singleton target property instance. */
+  public static final CheckpointingProperty INSTANCE = new CheckpointingProperty();
+
+  private CheckpointingProperty() {
+    super();
+  }
+
+  @Override
+  public String name() {
+    return "checkpointing";
+  }
+}
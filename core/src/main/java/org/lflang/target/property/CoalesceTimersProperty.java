@@ -0,0 +1,25 @@
+package org.lflang.target.property;
+
+/**
+ * If true, let timers of the same reactor that share an offset and period drive their reactions
+ * through a single runtime timer.
+ *
+ * <p>This option is currently only used for C++. Timers with identical schedules fire at exactly
+ * the same tags, so all but one of them can become references to a shared {@code reactor::Timer},
+ * collapsing their event queue entries into one. Reactions observe the same triggering behavior;
+ * only runtime introspection (such as trace output) sees the shared timer's name.
+ */
+public final class CoalesceTimersProperty extends BooleanProperty {
+
+  /** Singleton target property instance. */
+  public static final CoalesceTimersProperty INSTANCE = new CoalesceTimersProperty();
+
+  private CoalesceTimersProperty() {
+    super();
+  }
+
+  @Override
+  public String name() {
+    return "coalesce-timers";
+  }
+}
@@ -0,0 +1,25 @@
+package org.lflang.target.property;
+
+/**
+ * If true, place all members of a reactor bank into one contiguous storage arena instead of
+ * heap-allocating each member separately.
+ *
+ * <p>This option is currently only used for C++. Bank members are placement-constructed in
+ * declaration order, so iterating a bank in assemble() loops and reaction views becomes a
+ * sequential memory traversal. The bank_index parameter behaves exactly as with the default
+ * storage mode. Enclave banks are excluded, since their members own separate environments.
+ */
+public final class ContiguousBanksProperty extends BooleanProperty {
+
+  /** Singleton target property instance. */
+  public static final ContiguousBanksProperty INSTANCE = new ContiguousBanksProperty();
+
+  private ContiguousBanksProperty() {
+    super();
+  }
+
+  @Override
+  public String name() {
+    return "contiguous-banks";
+  }
+}
@@ -0,0 +1,49 @@
+package org.lflang.target.property;
+
+import org.lflang.MessageReporter;
+import org.lflang.ast.ASTUtils;
+import org.lflang.lf.Element;
+import org.lflang.target.property.type.EventQueueType;
+import org.lflang.target.property.type.EventQueueType.EventQueue;
+
+/**
+ * Directive to select the event queue structure of the C++ runtime.
+ *
+ * <p>This option is currently only used for C++. The selection is forwarded to the reactor-cpp
+ * build, so it takes effect when the runtime is compiled; the generated program reports the
+ * compiled-in structure through its {@code --event-queue} command line option. The default keeps
+ * the queue the runtime ships with.
+ */
+public final class EventQueueProperty extends TargetProperty<EventQueue, EventQueueType> {
+
+  /** Singleton target property instance. */
+  public static final EventQueueProperty INSTANCE = new EventQueueProperty();
+
+  private EventQueueProperty() {
+    super(new EventQueueType());
+  }
+
+  @Override
+  public EventQueue initialValue() {
+    return EventQueue.getDefault();
+  }
+
+  @Override
+  protected EventQueue fromAst(Element node, MessageReporter reporter) {
+    return fromString(ASTUtils.elementToSingleString(node), reporter);
+  }
+
+  protected EventQueue fromString(String string, MessageReporter reporter) {
+    return EventQueue.valueOf(string.toUpperCase().replace('-', '_'));
+  }
+
+  @Override
+  public Element toAstElement(EventQueue value) {
+    return ASTUtils.toElement(value.toString());
+  }
+
+  @Override
+  public String name() {
+    return "event-queue";
+  }
+}
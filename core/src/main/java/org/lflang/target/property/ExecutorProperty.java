@@ -0,0 +1,49 @@
+package org.lflang.target.property;
+
+import org.lflang.MessageReporter;
+import org.lflang.ast.ASTUtils;
+import org.lflang.lf.Element;
+import org.lflang.target.property.type.ExecutorType;
+import org.lflang.target.property.type.ExecutorType.Executor;
+
+/**
+ * Directive to select the scheduling policy of the C++ runtime.
+ *
+ * <p>This option is currently only used for C++. The selection is forwarded to the reactor-cpp
+ * build, so it takes effect when the runtime is compiled; the generated program reports the
+ * compiled-in policy through its {@code --scheduler} command line option. The default keeps the
+ * executor the runtime ships with.
+ */
+public final class ExecutorProperty extends TargetProperty<Executor, ExecutorType> {
+
+  /** Singleton target property instance. */
+  public static final ExecutorProperty INSTANCE = new ExecutorProperty();
+
+  private ExecutorProperty() {
+    super(new ExecutorType());
+  }
+
+  @Override
+  public Executor initialValue() {
+    return Executor.getDefault();
+  }
+
+  @Override
+  protected Executor fromAst(Element node, MessageReporter reporter) {
+    return fromString(ASTUtils.elementToSingleString(node), reporter);
+  }
+
+  protected Executor fromString(String string, MessageReporter reporter) {
+    return Executor.valueOf(string.toUpperCase().replace('-', '_'));
+  }
+
+  @Override
+  public Element toAstElement(Executor value) {
+    return ASTUtils.toElement(value.toString());
+  }
+
+  @Override
+  public String name() {
+    return "scheduler";
+  }
+}
@@ -0,0 +1,26 @@
+package org.lflang.target.property;
+
+/**
+ * If true, parse main-reactor parameters through a generated lookup table instead of registering
+ * one cxxopts option per parameter.
+ *
+ * <p>This option is currently only used for C++. Programs with hundreds of main-reactor parameters
+ * spend visible time in option registration and stringstream-based default-value rendering before
+ * the reactor program is even assembled; the table-driven parser avoids both. Core options such as
+ * {@code --workers} and {@code --help} are still handled by cxxopts, but {@code --help} no longer
+ * lists the individual main-reactor parameters.
+ */
+public final class FastParameterParsingProperty extends BooleanProperty {
+
+  /** Singleton target property instance. */
+  public static final FastParameterParsingProperty INSTANCE = new FastParameterParsingProperty();
+
+  private FastParameterParsingProperty() {
+    super();
+  }
+
+  @Override
+  public String name() {
+    return "fast-parameter-parsing";
+  }
+}
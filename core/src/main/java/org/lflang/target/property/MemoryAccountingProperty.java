@@ -0,0 +1,27 @@
+package org.lflang.target.property;
+
+/**
+ * If true, attribute heap usage to individual reactor instances and enable {@code
+ * --dump-memory-stats}.
+ *
+ * <p>This option is currently only used for C++. The generated main replaces the global allocation
+ * functions with an accounting allocator, and every reactor subtree is constructed inside an
+ * accounting scope, so all memory allocated while building an instance is attributed to its fully
+ * qualified name. With {@code --dump-memory-stats}, live bytes (self and subtree) and cumulative
+ * allocation counts are printed per reactor at shutdown. When the property is disabled, no
+ * accounting code is generated and allocation takes its usual path.
+ */
+public final class MemoryAccountingProperty extends BooleanProperty {
+
+  /** Singleton target property instance. */
+  public static final MemoryAccountingProperty INSTANCE = new MemoryAccountingProperty();
+
+  private MemoryAccountingProperty() {
+    super();
+  }
+
+  @Override
+  public String name() {
+    return "memory-accounting";
+  }
+}
@@ -0,0 +1,24 @@
+package org.lflang.target.property;
+
+/**
+ * If true, compile enter/exit trace hooks into every generated reaction body and deadline handler.
+ *
+ * <p>This option is currently only used for C++. The hooks write fixed-size records into
+ * per-worker lock-free ring buffers that a background thread drains into a Chrome trace-event
+ * (Perfetto-compatible) JSON file. When the property is off, the hooks expand to nothing and add
+ * zero overhead.
+ */
+public final class ReactionTracingProperty extends BooleanProperty {
+
+  /** Singleton target property instance. */
+  public static final ReactionTracingProperty INSTANCE = new ReactionTracingProperty();
+
+  private ReactionTracingProperty() {
+    super();
+  }
+
+  @Override
+  public String name() {
+    return "reaction-tracing";
+  }
+}
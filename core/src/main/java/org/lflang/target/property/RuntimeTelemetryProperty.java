@@ -0,0 +1,25 @@
+package org.lflang.target.property;
+
+/**
+ * If true, compile lock-free telemetry counters into the generated program and offer a
+ * {@code --metrics-port} command line option that serves live counter snapshots over TCP.
+ *
+ * <p>This option is currently only used for C++. Every reaction body and deadline handler
+ * increments a per-call-site counter with a single relaxed atomic add, and a background thread
+ * serves snapshots of all counters in a small binary format whenever a client connects. When the
+ * property is off, the hooks expand to nothing and add zero overhead.
+ */
+public final class RuntimeTelemetryProperty extends BooleanProperty {
+
+  /** Singleton target property instance. */
+  public static final RuntimeTelemetryProperty INSTANCE = new RuntimeTelemetryProperty();
+
+  private RuntimeTelemetryProperty() {
+    super();
+  }
+
+  @Override
+  public String name() {
+    return "runtime-telemetry";
+  }
+}
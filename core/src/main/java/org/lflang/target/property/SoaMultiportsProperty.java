@@ -0,0 +1,26 @@
+package org.lflang.target.property;
+
+/**
+ * If true, expose multiport values to reactions through a contiguous structure-of-arrays view.
+ *
+ * <p>This option is currently only used for C++. Multiports store their values scattered across
+ * individual port objects, so a reaction that reduces over a wide multiport chases a pointer per
+ * channel and cannot vectorize. With this option, every reaction that reads a multiport {@code p}
+ * additionally receives a {@code p_soa} argument holding one contiguous value array plus a
+ * presence bitmask, so numeric reductions become SIMD-friendly linear loops. Writing to a
+ * multiport is unaffected.
+ */
+public final class SoaMultiportsProperty extends BooleanProperty {
+
+  /** Singleton target property instance. */
+  public static final SoaMultiportsProperty INSTANCE = new SoaMultiportsProperty();
+
+  private SoaMultiportsProperty() {
+    super();
+  }
+
+  @Override
+  public String name() {
+    return "soa-multiports";
+  }
+}
@@ -0,0 +1,25 @@
+package org.lflang.target.property;
+
+/**
+ * If true, compile the generated C++ sources as a unity (jumbo) build.
+ *
+ * <p>This option is currently only used for C++. The generated CMake code batches the reactor
+ * translation units into unity aggregates and precompiles {@code reactor-cpp/reactor-cpp.hh}, so
+ * the runtime headers are parsed once per batch instead of once per reactor source file. This can
+ * cut compile times for programs with many reactors substantially without changing runtime
+ * behavior. Requires CMake 3.16 or newer; older versions fall back to a regular build.
+ */
+public final class UnityBuildProperty extends BooleanProperty {
+
+  /** Singleton target property instance. */
+  public static final UnityBuildProperty INSTANCE = new UnityBuildProperty();
+
+  private UnityBuildProperty() {
+    super();
+  }
+
+  @Override
+  public String name() {
+    return "unity-build";
+  }
+}
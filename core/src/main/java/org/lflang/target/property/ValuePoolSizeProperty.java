@@ -0,0 +1,54 @@
+package org.lflang.target.property;
+
+import org.lflang.MessageReporter;
+import org.lflang.ast.ASTUtils;
+import org.lflang.lf.Element;
+import org.lflang.target.property.type.PrimitiveType;
+
+/**
+ * The number of message value blocks each worker thread keeps in its local free list. The default
+ * is zero, which disables pooling and allocates all message values on the general-purpose heap.
+ *
+ * <p>This option is currently only used for C++. When set to a positive value, value storage
+ * obtained via {@code lfutil::make_pooled_value} is recycled through per-worker free lists, so
+ * steady-state operation performs no heap allocations on the message path.
+ *
+ * <p>Pooling is opt-in at the call site: reaction bodies must construct values explicitly with
+ * {@code lfutil::make_pooled_value<T>(...)} and pass the resulting pointer to {@code set()} or
+ * {@code schedule()}, e.g. {@code out.set(lfutil::make_pooled_value<int>(42))}. Values passed by
+ * value are still allocated by the runtime and never touch the pool.
+ */
+public final class ValuePoolSizeProperty extends TargetProperty<Integer, PrimitiveType> {
+
+  /** Singleton target property instance. */
+  public static final ValuePoolSizeProperty INSTANCE = new ValuePoolSizeProperty();
+
+  private ValuePoolSizeProperty() {
+    super(PrimitiveType.NON_NEGATIVE_INTEGER);
+  }
+
+  @Override
+  public Integer initialValue() {
+    return 0;
+  }
+
+  @Override
+  protected Integer fromString(String string, MessageReporter reporter) {
+    return Integer.parseInt(string);
+  }
+
+  @Override
+  protected Integer fromAst(Element node, MessageReporter reporter) {
+    return ASTUtils.toInteger(node);
+  }
+
+  @Override
+  public Element toAstElement(Integer value) {
+    return ASTUtils.toElement(value);
+  }
+
+  @Override
+  public String name() {
+    return "value-pool-size";
+  }
+}
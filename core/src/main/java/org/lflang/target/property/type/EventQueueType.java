@@ -0,0 +1,40 @@
+package org.lflang.target.property.type;
+
+import org.lflang.target.property.type.EventQueueType.EventQueue;
+
+public class EventQueueType extends OptionsType<EventQueue> {
+
+  @Override
+  protected Class<EventQueue> enumClass() {
+    return EventQueue.class;
+  }
+
+  /**
+   * Event queue structures for the C++ runtime.
+   *
+   * <p>The structure is fixed when the runtime is built: it is forwarded to the reactor-cpp build
+   * as the REACTOR_CPP_EVENT_QUEUE cache variable. BINARY_HEAP favors sparse timer workloads,
+   * CALENDAR_QUEUE favors microstep-heavy simulation with many events per epoch, and DEFAULT keeps
+   * whatever queue the runtime ships with.
+   */
+  public enum EventQueue {
+    DEFAULT,
+    BINARY_HEAP,
+    CALENDAR_QUEUE;
+
+    /** Return the name in kebab case, as used in LF source and on the command line. */
+    @Override
+    public String toString() {
+      return this.name().toLowerCase().replace('_', '-');
+    }
+
+    /** Return the value of the REACTOR_CPP_EVENT_QUEUE cache variable selecting this queue. */
+    public String getCmakeName() {
+      return this.name();
+    }
+
+    public static EventQueue getDefault() {
+      return EventQueue.DEFAULT;
+    }
+  }
+}
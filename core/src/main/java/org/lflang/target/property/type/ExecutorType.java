@@ -0,0 +1,40 @@
+package org.lflang.target.property.type;
+
+import org.lflang.target.property.type.ExecutorType.Executor;
+
+public class ExecutorType extends OptionsType<Executor> {
+
+  @Override
+  protected Class<Executor> enumClass() {
+    return Executor.class;
+  }
+
+  /**
+   * Execution policies for the C++ runtime scheduler.
+   *
+   * <p>The policy is fixed when the runtime is built: it is forwarded to the reactor-cpp build as
+   * the REACTOR_CPP_SCHEDULER cache variable. DEFAULT keeps whatever executor the runtime ships
+   * with.
+   */
+  public enum Executor {
+    DEFAULT,
+    GLOBAL_QUEUE,
+    WORK_STEALING,
+    BUSY_SPIN;
+
+    /** Return the name in kebab case, as used in LF source and on the command line. */
+    @Override
+    public String toString() {
+      return this.name().toLowerCase().replace('_', '-');
+    }
+
+    /** Return the value of the REACTOR_CPP_SCHEDULER cache variable selecting this executor. */
+    public String getCmakeName() {
+      return this.name();
+    }
+
+    public static Executor getDefault() {
+      return Executor.DEFAULT;
+    }
+  }
+}
@@ -406,7 +406,8 @@ public class FileUtil {
     final var parent = destination.getParent();
     if (Files.isRegularFile(destination)) {
       if (skipIfUnchanged) {
-        if (Arrays.equals(bytes, Files.readAllBytes(destination))) {
+        if (bytes.length == Files.size(destination)
+            && Arrays.equals(bytes, Files.readAllBytes(destination))) {
           // Abort if the file contents are the same.
           return;
         }
@@ -934,6 +935,10 @@ public class FileUtil {
   public static boolean isSame(String text, Path path) throws IOException {
     if (Files.isRegularFile(path)) {
       final byte[] bytes = text.getBytes();
+      // Check the file size first so that a changed file is rejected without reading it back.
+      if (bytes.length != Files.size(path)) {
+        return false;
+      }
       return Arrays.equals(bytes, Files.readAllBytes(path));
     }
     return false;
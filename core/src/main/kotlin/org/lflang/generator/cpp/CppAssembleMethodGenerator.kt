@@ -108,6 +108,13 @@ class CppAssembleMethodGenerator(private val reactor: Reactor) {
             }
         }
 
+    /**
+     * The connection properties passed to the runtime when the connection is drawn.
+     *
+     * Delays travel as part of the properties rather than as a generated action plus forwarding
+     * reactions, so a message on a delayed connection is shifted to the later tag by the runtime's
+     * connection object in a single event queue operation.
+     */
     private val Connection.properties: String
         get() = "reactor::ConnectionProperties{$cppType, $cppDelay, nullptr}"
 
@@ -180,30 +187,38 @@ class CppAssembleMethodGenerator(private val reactor: Reactor) {
         // first left port to determine the type of the entire connection
         val portType = c.leftPorts[0].portType
 
-        // Generate code which adds all left hand ports and all right hand ports to a vector each. If we are handling multiports
+        // Generate code which adds all left hand ports and all right hand ports to a table each. If we are handling multiports
         // within a bank, then we normally iterate over all banks in an outer loop and over all ports in an inner loop. However,
         // if the connection is an interleaved connection, than we change the order on the right side and iterate over ports before banks.
         return with(PrependOperator) {
             """
                 |// connection $idx
                 |std::vector<$portType> __lf_left_ports_$idx;
+                |__lf_left_ports_$idx.reserve(${c.leftPorts.joinToString(" + ") { it.portCount }});
             ${" |"..c.leftPorts.joinWithLn { addAllPortsToVector(it, "__lf_left_ports_$idx") }}
                 |std::vector<$portType> __lf_right_ports_$idx;
+                |__lf_right_ports_$idx.reserve(${c.rightPorts.joinToString(" + ") { it.portCount }});
             ${" |"..c.rightPorts.joinWithLn { addAllPortsToVector(it, "__lf_right_ports_$idx") }}
-                |lfutil::bind_multiple_ports<$portType>(__lf_left_ports_$idx, __lf_right_ports_$idx, ${c.isIterated},
-            ${" |"..c.getConnectionLambda(portType)}
-                |);
+                |lfutil::draw_connections<$portType>(__lf_left_ports_$idx, __lf_right_ports_$idx, ${c.isIterated}, ${c.properties});
             """.trimMargin()
         }
     }
 
-    private fun Connection.getConnectionLambda(portType: String): String {
-        return """
-            [&]($portType left, $portType right) {
-                left->environment()->draw_connection(left, right, $properties);
+    /** Get an expression for the total number of ports covered by the given port reference. */
+    private val VarRef.portCount: String
+        get() {
+            val port = variable as Port
+            val container: Instantiation? = container
+            val instanceRef = if (container?.isEnclave == true) "__lf_instance->" else ""
+            return when {
+                port.isMultiport && container?.isBank == true ->
+                    "(${container.name}.size() * ${container.name}[0]->$instanceRef${port.name}.size())"
+
+                port.isMultiport                              -> "$name.size()"
+                container?.isBank == true                     -> "${container.name}.size()"
+                else                                          -> "1"
             }
-        """.trimIndent()
-    }
+        }
 
     private fun addAllPortsToVector(varRef: VarRef, vectorName: String): String =
         iterateOverAllPortsAndApply(varRef) { port: String -> "${vectorName}.push_back(&$port);" }
@@ -94,6 +94,16 @@ fun WidthSpec.toCppCode(): String = terms.joinToString(" + ") {
     }
 }
 
+/** The compile-time constant value of a width, or null if it is only known at runtime. */
+val WidthSpec.constantWidth: Int?
+    get() {
+        if (terms.isEmpty() || terms.any { it.parameter != null || it.port != null || it.code != null }) {
+            return null
+        }
+        val width = terms.sumOf { it.width }
+        return if (width > 0) width else null
+    }
+
 /** True if the preamble is public */
 val Preamble.isPublic: Boolean get() = this.visibility == Visibility.PUBLIC
 
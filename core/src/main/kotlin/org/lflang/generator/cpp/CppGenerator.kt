@@ -32,7 +32,9 @@ import org.lflang.generator.GeneratorUtils.canGenerate
 import org.lflang.generator.LFGeneratorContext.Mode
 import org.lflang.generator.docker.DockerGenerator
 import org.lflang.isGeneric
+import org.lflang.lf.Reactor
 import org.lflang.scoping.LFGlobalScopeProvider
+import org.lflang.toText
 import org.lflang.target.Target
 import org.lflang.target.property.*
 import org.lflang.util.FileUtil
@@ -186,9 +188,20 @@ class CppGenerator(
             }
         }
 
+        // map each generic reactor to the concrete type argument lists it is instantiated with;
+        // instantiations inside other generic reactors are skipped, as their type arguments may
+        // depend on the enclosing reactor's type parameters
+        val concreteTypeArgs = mutableMapOf<Reactor, MutableSet<String>>()
+        for (r in reactors.filterNot { it.isGeneric }) {
+            for (inst in r.instantiations.filter { it.reactor.isGeneric }) {
+                concreteTypeArgs.getOrPut(inst.reactor) { linkedSetOf() }
+                    .add(inst.typeArgs.joinToString(", ") { it.toText() })
+            }
+        }
+
         // generate header and source files for all reactors
         for (r in reactors) {
-            val generator = CppReactorGenerator(r, fileConfig, messageReporter)
+            val generator = CppReactorGenerator(r, fileConfig, messageReporter, targetConfig, concreteTypeArgs[r].orEmpty())
             val headerFile = fileConfig.getReactorHeaderPath(r)
             val sourceFile = if (r.isGeneric) fileConfig.getReactorHeaderImplPath(r) else fileConfig.getReactorSourcePath(r)
             val reactorCodeMap = CodeMap.fromGeneratedCode(generator.generateSource())
@@ -200,6 +213,16 @@ class CppGenerator(
 
             FileUtil.writeToFile(headerCodeMap.generatedCode, srcGenPath.resolve(headerFile), true)
             FileUtil.writeToFile(reactorCodeMap.generatedCode, srcGenPath.resolve(sourceFile), true)
+
+            // compile each generic reactor's explicit instantiations once instead of in every
+            // translation unit that includes the header
+            if (r.isGeneric && r in concreteTypeArgs) {
+                val instantiationFile = fileConfig.getReactorSourcePath(r)
+                val instantiationCodeMap = CodeMap.fromGeneratedCode(generator.generateInstantiationSource())
+                cppSources.add(instantiationFile)
+                codeMaps[srcGenPath.resolve(instantiationFile)] = instantiationCodeMap
+                FileUtil.writeToFile(instantiationCodeMap.generatedCode, srcGenPath.resolve(instantiationFile), true)
+            }
         }
 
 
@@ -28,13 +28,17 @@ import org.lflang.*
 import org.lflang.generator.PrependOperator
 import org.lflang.lf.Instantiation
 import org.lflang.lf.Reactor
+import org.lflang.target.TargetConfig
+import org.lflang.target.property.ContiguousBanksProperty
+import org.lflang.target.property.MemoryAccountingProperty
 import org.lflang.validation.AttributeSpec
 
 /** A code generator for reactor instances */
 class CppInstanceGenerator(
     private val reactor: Reactor,
     private val fileConfig: CppFileConfig,
-    private val messageReporter: MessageReporter
+    private val messageReporter: MessageReporter,
+    private val targetConfig: TargetConfig,
 ) {
     companion object {
         val Instantiation.isEnclave: Boolean get() = AttributeUtils.isEnclave(this)
@@ -70,8 +74,33 @@ class CppInstanceGenerator(
             |};
         """.trimMargin()
 
+    /** True if the members of the given bank live in one contiguous storage arena. */
+    private val Instantiation.isContiguousBank: Boolean
+        get() = isBank && !isEnclave && targetConfig.get(ContiguousBanksProperty.INSTANCE)
+
+    private val memoryAccounting = targetConfig.get(MemoryAccountingProperty.INSTANCE)
+
+    /** The compile-time constant width of this bank, or null if it is only known at runtime. */
+    private val Instantiation.constantBankWidth: Int?
+        get() = widthSpec?.constantWidth
+
+    /**
+     * The C++ container type holding the members of this bank. Banks with a literal width become
+     * a std::array with the width as a template constant, so the assembly loops iterate over a
+     * compile-time bound and member access skips the vector's heap indirection.
+     */
+    private fun Instantiation.bankContainerType(member: String): String =
+        constantBankWidth?.let { "std::array<$member, $it>" } ?: "std::vector<$member>"
+
     private fun generateDeclaration(inst: Instantiation): String = with(inst) {
-        val instance = if (isBank) "std::vector<std::unique_ptr<$cppClass>>" else "std::unique_ptr<$cppClass>"
+        if (isContiguousBank) {
+            // the arena must be declared before the bank container, so that the members are destroyed first
+            return """
+                lfutil::BankStorage<$cppClass> __lf_${name}_storage;
+                ${bankContainerType("lfutil::arena_ptr<$cppClass>")} $name;
+            """.trimIndent()
+        }
+        val instance = if (isBank) bankContainerType("std::unique_ptr<$cppClass>") else "std::unique_ptr<$cppClass>"
         if (isEnclave) {
             return with(PrependOperator) {
                 """
@@ -107,19 +136,35 @@ class CppInstanceGenerator(
     }
 
     private fun generateInitializer(inst: Instantiation): String? = with(inst) {
-        if (isBank) null else """, $name(std::make_unique<$cppClass>("$name", this, ${getParameterStruct()}))"""
+        if (isBank) return null
+        val create = """std::make_unique<$cppClass>("$name", this, ${getParameterStruct()})"""
+        if (memoryAccounting)
+            """, $name(lfutil::memory::scoped_construct(fqn() + ".$name", [&]() { return $create; }))"""
+        else
+            ", $name($create)"
     }
 
     private fun generateConstructorInitializer(inst: Instantiation): String {
         with(inst) {
             assert(isBank)
             val width = inst.widthSpec.toCppCode()
+            val make =
+                if (isContiguousBank) "__lf_${name}_storage.emplace(__lf_inst_name, this, ${inst.getParameterStruct()})"
+                else "std::make_unique<$cppClass>(__lf_inst_name, this, ${inst.getParameterStruct()})"
+            val create =
+                if (memoryAccounting) """lfutil::memory::scoped_construct(fqn() + "." + __lf_inst_name, [&]() { return $make; })"""
+                else make
+            // a constant-width bank is a std::array and its members are assigned in place
+            val insert =
+                if (constantBankWidth != null) "$name[__lf_idx] = $create;"
+                else "$name.emplace_back($create);"
             return """
                 |// initialize instance $name
-                |$name.reserve($width);
+                |${if (isContiguousBank) "__lf_${name}_storage.reserve($width);" else ""}
+                |${if (constantBankWidth == null) "$name.reserve($width);" else ""}
                 |for (size_t __lf_idx = 0; __lf_idx < $width; __lf_idx++) {
                 |  std::string __lf_inst_name = "${name}_" + std::to_string(__lf_idx);
-                |  $name.emplace_back(std::make_unique<$cppClass>(__lf_inst_name, this, ${inst.getParameterStruct()}));
+                |  $insert
                 |}
             """.trimMargin()
         }
@@ -142,6 +187,27 @@ class CppInstanceGenerator(
     fun generateConstructorInitializers() =
         reactor.instantiations.filter { it.isBank }.joinWithLn { generateConstructorInitializer(it) }
 
+    /**
+     * Generate calls that apply the given checkpoint operation to all contained reactor instances.
+     *
+     * [operation] is the call to forward, e.g. `__lf_checkpoint_save(writer)`. Banks are visited
+     * in index order and enclaves are unwrapped, so the traversal order only depends on the
+     * declaration order of the instantiations.
+     */
+    fun generateCheckpointTraversal(operation: String): String =
+        reactor.instantiations.joinWithLn {
+            val deref = if (it.isEnclave) "->__lf_instance" else ""
+            if (it.isBank) {
+                """
+                    for (auto& __lf_instance : ${it.name}) {
+                      __lf_instance$deref->$operation;
+                    }
+                """.trimIndent()
+            } else {
+                "${it.name}$deref->$operation;"
+            }
+        }
+
     /** Generate constructor initializers for all reactor instantiations */
     fun generateInitializers(): String =
         reactor.instantiations.mapNotNull { generateInitializer(it) }
@@ -6,6 +6,8 @@ import org.lflang.generator.GeneratorCommandFactory
 import org.lflang.generator.LFGeneratorContext
 import org.lflang.generator.docker.DockerGenerator
 import org.lflang.target.property.BuildTypeProperty
+import org.lflang.target.property.EventQueueProperty
+import org.lflang.target.property.ExecutorProperty
 import org.lflang.target.property.LoggingProperty
 import org.lflang.target.property.NoRuntimeValidationProperty
 import org.lflang.target.property.PrintStatisticsProperty
@@ -38,6 +40,8 @@ abstract class CppPlatformGenerator(protected val generator: CppGenerator) {
             "-DREACTOR_CPP_PRINT_STATISTICS=${if (targetConfig.get(PrintStatisticsProperty.INSTANCE)) "ON" else "OFF"}",
             "-DREACTOR_CPP_TRACE=${if (targetConfig.get(TracingProperty.INSTANCE).isEnabled) "ON" else "OFF"}",
             "-DREACTOR_CPP_LOG_LEVEL=${targetConfig.get(LoggingProperty.INSTANCE).severity}",
+            "-DREACTOR_CPP_SCHEDULER=${targetConfig.get(ExecutorProperty.INSTANCE).cmakeName}",
+            "-DREACTOR_CPP_EVENT_QUEUE=${targetConfig.get(EventQueueProperty.INSTANCE).cmakeName}",
             "-DLF_SRC_PKG_PATH=${fileConfig.srcPkgPath}",
         )
 
@@ -31,12 +31,22 @@ import org.lflang.isBank
 import org.lflang.isMultiport
 import org.lflang.joinWithLn
 import org.lflang.lf.*
+import org.lflang.target.TargetConfig
+import org.lflang.target.property.SoaMultiportsProperty
 
-class CppPortGenerator(private val reactor: Reactor) {
+class CppPortGenerator(private val reactor: Reactor, private val targetConfig: TargetConfig) {
+
+    private val soaMultiports = targetConfig.get(SoaMultiportsProperty.INSTANCE)
 
     companion object {
         private val VarRef.isMultiport get() = (variable as? Port)?.isMultiport == true
 
+        /**
+         * True if the port's data type can back a SoaView. Void ports carry no values to gather,
+         * and a `SoaView<void>` would not even compile.
+         */
+        val Port.supportsSoaView: Boolean get() = isMultiport && inferredType.cppType != "void"
+
         /**
          * Return the C++ type of a port reference.
          *
@@ -60,7 +70,15 @@ class CppPortGenerator(private val reactor: Reactor) {
     private fun generateDeclaration(port: Port): String = with(port) {
         return if (isMultiport) {
             //val initializerLists = (0 until getValidWidth()).joinToString(", ") { """{"${name}_$it", this}""" }
-            """$cppType $name;"""
+            if (soaMultiports && supportsSoaView) {
+                """
+                    $cppType $name;
+                    mutable lfutil::SoaView<${inferredType.cppType}> __lf_${name}_soa{};
+                    const lfutil::SoaView<${inferredType.cppType}>& ${name}_soa() const { __lf_${name}_soa.load($name); return __lf_${name}_soa; }
+                """.trimIndent()
+            } else {
+                """$cppType $name;"""
+            }
         } else {
             """$cppType $name{"$name", this};"""
         }
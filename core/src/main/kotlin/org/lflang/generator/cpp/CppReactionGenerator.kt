@@ -26,7 +26,10 @@ package org.lflang.generator.cpp
 
 import org.lflang.generator.PrependOperator
 import org.lflang.generator.cpp.CppInstanceGenerator.Companion.cppClass
+import org.lflang.generator.cpp.CppPortGenerator.Companion.supportsSoaView
+import org.lflang.inferredType
 import org.lflang.isBank
+import org.lflang.isMultiport
 import org.lflang.joinWithLn
 import org.lflang.label
 import org.lflang.lf.Action
@@ -40,16 +43,21 @@ import org.lflang.lf.Timer
 import org.lflang.lf.TriggerRef
 import org.lflang.lf.VarRef
 import org.lflang.priority
+import org.lflang.target.TargetConfig
+import org.lflang.target.property.SoaMultiportsProperty
 import org.lflang.toText
 
 /** A C++ code generator for reactions and their function bodies */
 class CppReactionGenerator(
     private val reactor: Reactor,
-    private val portGenerator: CppPortGenerator
+    private val portGenerator: CppPortGenerator,
+    private val targetConfig: TargetConfig,
 ) {
 
     private val reactionsWithDeadlines = reactor.reactions.filter { it.deadline != null }
 
+    private val soaMultiports = targetConfig.get(SoaMultiportsProperty.INSTANCE)
+
     private val VarRef.isContainedRef: Boolean get() = container != null
     private val TriggerRef.isContainedRef: Boolean get() = this is VarRef && isContainedRef
 
@@ -64,6 +72,13 @@ class CppReactionGenerator(
     private val Reaction.allVariableReferences get() = (effects + sources + triggers.mapNotNull { it as? VarRef }).distinct()
     private val Reaction.allReferencedContainers get() = allVariableReferences.mapNotNull { it.container }.distinct()
 
+    /** All multiports that the given reaction reads and that receive an additional SoA view argument. */
+    private val Reaction.allSoaMultiportReads: List<VarRef>
+        get() = if (!soaMultiports) emptyList()
+        else (allUncontainedTriggers.mapNotNull { it as? VarRef } + allUncontainedSources)
+            .filter { (it.variable as? Port)?.supportsSoaView == true }
+            .distinct()
+
     private fun Reaction.getAllReferencedVariablesForContainer(container: Instantiation) =
         allVariableReferences.filter { it.container == container }.distinct()
 
@@ -91,6 +106,7 @@ class CppReactionGenerator(
         allUncontainedTriggers.map { "[[maybe_unused]] const ${it.cppType}& ${it.name}" } +
                 allUncontainedSources.map { "const ${it.cppType}& ${it.name}" } +
                 allUncontainedEffects.map { "${it.cppType}& ${it.name}" } +
+                allSoaMultiportReads.map { "const lfutil::SoaView<${(it.variable as Port).inferredType.cppType}>& ${it.name}_soa" } +
                 allReferencedContainers.map {
                     if (it.isBank) "const std::vector<${getViewClassName(it)}>& ${it.name}"
                     else "${getViewClassName(it)}& ${it.name}"
@@ -101,6 +117,7 @@ class CppReactionGenerator(
             val parameters = allUncontainedTriggers.map { it.name } +
                     allUncontainedSources.map { it.name } +
                     allUncontainedEffects.map { it.name } +
+                    allSoaMultiportReads.map { "${it.name}_soa()" } +
                     allReferencedContainers.map { getViewInstanceName(it) }
             val body = "void ${codeName}_body() { __lf_inner.${codeName}(${parameters.joinToString(", ")}); }"
             val deadlineHandler =
@@ -157,6 +174,8 @@ class CppReactionGenerator(
                 |// reaction ${reaction.label}
                 |${reactor.templateLine}
             ${" |"..getFunctionDefinitionSignature(reaction, null)} {
+                |  LF_TRACE_REACTION_SCOPE("${reactor.name}", "${reaction.codeName}");
+                |  LF_TELEMETRY_COUNT("${reactor.name}.${reaction.codeName}.invocations");
             ${" |  "..reaction.code.toText()}
                 |}
                 |
@@ -168,6 +187,8 @@ class CppReactionGenerator(
         return """
             |${reactor.templateLine}
         ${" |"..getFunctionDefinitionSignature(reaction, "deadline_handler")} {
+            |  LF_TRACE_REACTION_SCOPE("${reactor.name}", "${reaction.codeName}_deadline_handler");
+            |  LF_TELEMETRY_COUNT("${reactor.name}.${reaction.codeName}.deadline_misses");
         ${" |  "..reaction.deadline.code.toText()}
             |}
             |
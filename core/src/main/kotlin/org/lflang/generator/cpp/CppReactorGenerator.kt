@@ -26,14 +26,23 @@ package org.lflang.generator.cpp
 import org.lflang.MessageReporter
 import org.lflang.generator.PrependOperator
 import org.lflang.isGeneric
+import org.lflang.joinWithLn
 import org.lflang.lf.Reactor
+import org.lflang.target.TargetConfig
+import org.lflang.target.property.CheckpointingProperty
 import org.lflang.toText
 import org.lflang.toUnixString
 
 /**
  * A C++ code generator that produces a C++ class representing a single reactor
  */
-class CppReactorGenerator(private val reactor: Reactor, fileConfig: CppFileConfig, messageReporter: MessageReporter) {
+class CppReactorGenerator(
+    private val reactor: Reactor,
+    fileConfig: CppFileConfig,
+    messageReporter: MessageReporter,
+    targetConfig: TargetConfig,
+    private val concreteTypeArgs: Set<String> = emptySet(),
+) {
 
     /** Comment to be inserted at the top of generated files */
     private val fileComment = fileComment(reactor.eResource())
@@ -47,14 +56,16 @@ class CppReactorGenerator(private val reactor: Reactor, fileConfig: CppFileConfi
     /** The header file that contains the public file-level preamble of the file containing `reactor` */
     private val preambleHeaderFile = fileConfig.getPreambleHeaderPath(reactor.eResource()).toUnixString()
 
+    private val checkpointing = targetConfig.get(CheckpointingProperty.INSTANCE)
+
     private val parameters = CppParameterGenerator(reactor)
     private val state = CppStateGenerator(reactor)
     private val methods = CppMethodGenerator(reactor)
-    private val instances = CppInstanceGenerator(reactor, fileConfig, messageReporter)
-    private val timers = CppTimerGenerator(reactor)
+    private val instances = CppInstanceGenerator(reactor, fileConfig, messageReporter, targetConfig)
+    private val timers = CppTimerGenerator(reactor, targetConfig)
     private val actions = CppActionGenerator(reactor, messageReporter)
-    private val ports = CppPortGenerator(reactor)
-    private val reactions = CppReactionGenerator(reactor, ports)
+    private val ports = CppPortGenerator(reactor, targetConfig)
+    private val reactions = CppReactionGenerator(reactor, ports, targetConfig)
     private val assemble = CppAssembleMethodGenerator(reactor)
 
     private fun publicPreamble() =
@@ -101,6 +112,7 @@ class CppReactorGenerator(private val reactor: Reactor, fileConfig: CppFileConfi
         ${" |    "..methods.generateDeclarations()}
         ${" |    "..reactions.generateBodyDeclarations()}
         ${" |    "..reactions.generateDeadlineHandlerDeclarations()}
+        ${" |    "..if (checkpointing) state.generateCheckpointMethods() else ""}
             |
             |    Inner(reactor::Reactor* reactor, Parameters&& parameters);
             |
@@ -118,6 +130,7 @@ class CppReactorGenerator(private val reactor: Reactor, fileConfig: CppFileConfi
             |
             | public:
         ${" |  "..ports.generateDeclarations()}
+        ${" |  "..if (checkpointing) generateCheckpointMethods() else ""}
         ${" |  "..outerConstructorSignature(true)};
         ${" |  "..outerConstructorSignature(false)};
             |
@@ -125,6 +138,47 @@ class CppReactorGenerator(private val reactor: Reactor, fileConfig: CppFileConfi
             |};
             |
         ${" |"..if (reactor.isGeneric) """#include "$implHeaderFile"""" else ""}
+            |
+        ${" |"..generateExternTemplateDeclarations()}
+        """.trimMargin()
+    }
+
+    /**
+     * Generate extern template declarations for all concrete instantiations of this generic reactor.
+     *
+     * These suppress the implicit instantiation in every translation unit that includes the header;
+     * the matching explicit instantiations are emitted once by [generateInstantiationSource].
+     */
+    private fun generateExternTemplateDeclarations() =
+        if (concreteTypeArgs.isEmpty()) ""
+        else concreteTypeArgs.joinWithLn(prefix = "// instantiated once in ${reactor.name}.cc\n") {
+            "extern template class ${reactor.name}<$it>;"
+        }
+
+    /** Generate a C++ source file holding the explicit instantiations of this generic reactor. */
+    fun generateInstantiationSource() = with(PrependOperator) {
+        """
+        ${" |"..fileComment}
+            |
+            |#include "$headerFile"
+            |
+            |// explicit instantiations of ${reactor.name}, declared extern in the header
+        ${" |"..concreteTypeArgs.joinWithLn { "template class ${reactor.name}<$it>;" }}
+        """.trimMargin()
+    }
+
+    /** Generate public methods that save and restore the state of this reactor and all contained reactors. */
+    private fun generateCheckpointMethods() = with(PrependOperator) {
+        """
+            |// checkpointing
+            |void __lf_checkpoint_save(lfutil::checkpoint::Writer& writer) const {
+            |  __lf_inner.__lf_checkpoint_save(writer);
+        ${" |  "..instances.generateCheckpointTraversal("__lf_checkpoint_save(writer)")}
+            |}
+            |void __lf_checkpoint_restore(lfutil::checkpoint::Reader& reader) {
+            |  __lf_inner.__lf_checkpoint_restore(reader);
+        ${" |  "..instances.generateCheckpointTraversal("__lf_checkpoint_restore(reader)")}
+            |}
         """.trimMargin()
     }
 
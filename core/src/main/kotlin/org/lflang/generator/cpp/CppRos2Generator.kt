@@ -30,6 +30,11 @@ class CppRos2Generator(generator: CppGenerator) : CppPlatformGenerator(generator
             packagePath.resolve("src").resolve("${nodeGenerator.nodeName}.cc"),
             true
         )
+        FileUtil.writeToFile(
+            nodeGenerator.generateUtilHeader(),
+            packagePath.resolve("include").resolve("lf_ros2_util.hh"),
+            true
+        )
 
         FileUtil.writeToFile(packageGenerator.generatePackageXml(), packagePath.resolve("package.xml"), true)
         FileUtil.writeToFile(
@@ -42,7 +47,7 @@ class CppRos2Generator(generator: CppGenerator) : CppPlatformGenerator(generator
                 fileConfig.srcGenPath.resolve(relativeBinDir).resolve(fileConfig.name)
             else
                 fileConfig.binPath.resolve(fileConfig.name)
-        FileUtil.writeToFile(packageGenerator.generateBinScript(), scriptPath)
+        FileUtil.writeToFile(packageGenerator.generateBinScript(), scriptPath, true)
         scriptPath.toFile().setExecutable(true);
     }
 
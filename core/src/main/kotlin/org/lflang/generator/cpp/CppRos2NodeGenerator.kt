@@ -46,6 +46,53 @@ class CppRos2NodeGenerator(
         """.trimMargin()
     }
 
+    /**
+     * Generate a support header with publishing helpers for reaction bodies.
+     *
+     * Reactions in a ROS2 node publish through rclcpp publishers created on [lf_node]. The helper
+     * generated here uses the middleware's loaned-message (shared memory) transport when it is
+     * available for a publisher and transparently falls back to a regular serialized publish
+     * otherwise, so large messages to intra-host subscribers skip the serialization round-trip.
+     */
+    fun generateUtilHeader(): String {
+        return """
+            |#pragma once
+            |
+            |#include <memory>
+            |#include <utility>
+            |
+            |#include <rclcpp/rclcpp.hpp>
+            |
+            |namespace lfutil {
+            |namespace ros2 {
+            |
+            |/**
+            | * Publish a message, using the zero-copy loaned-message transport when available.
+            | *
+            | * If the middleware can loan messages on this publisher (all subscribers intra-host and a
+            | * shared-memory transport configured), the message is constructed directly in
+            | * middleware-owned memory and handed over without serialization. Otherwise the message is
+            | * built on the stack and published through the regular serialized path. The filler callable
+            | * receives a reference to the message to populate.
+            | */
+            |template <class MessageT, class Filler>
+            |void publish(rclcpp::Publisher<MessageT>& publisher, Filler&& fill) {
+            |  if (publisher.can_loan_messages()) {
+            |    auto loaned = publisher.borrow_loaned_message();
+            |    fill(loaned.get());
+            |    publisher.publish(std::move(loaned));
+            |  } else {
+            |    MessageT message{};
+            |    fill(message);
+            |    publisher.publish(message);
+            |  }
+            |}
+            |
+            |} // namespace ros2
+            |} // namespace lfutil
+        """.trimMargin()
+    }
+
     fun generateSource(): String {
         return """
             |#include "$nodeName.hh"
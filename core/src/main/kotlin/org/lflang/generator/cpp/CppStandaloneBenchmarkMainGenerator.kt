@@ -0,0 +1,135 @@
+package org.lflang.generator.cpp
+
+import org.lflang.target.TargetConfig
+import org.lflang.generator.PrependOperator
+import org.lflang.generator.cpp.CppStandaloneMainGenerator.Companion.generateFastParameterPrescan
+import org.lflang.generator.cpp.CppStandaloneMainGenerator.Companion.generateFastParameterValueParser
+import org.lflang.generator.cpp.CppStandaloneMainGenerator.Companion.generateMainReactorInstantiation
+import org.lflang.generator.cpp.CppStandaloneMainGenerator.Companion.generateParameterParser
+import org.lflang.lf.Reactor
+import org.lflang.target.property.FastParameterParsingProperty
+import org.lflang.target.property.FastProperty
+import org.lflang.target.property.TimeOutProperty
+import org.lflang.target.property.WorkersProperty
+import org.lflang.toUnixString
+
+/**
+ * C++ code generator responsible for generating the main file of a benchmark runner.
+ *
+ * This replaces the production main() when the benchmark target property is set. The generated
+ * runner executes the reactor program repeatedly, discards a configurable number of warmup
+ * iterations, records assembly and execution latencies in histograms, and reports the results as
+ * a JSON object.
+ */
+class CppStandaloneBenchmarkMainGenerator(
+    private val main: Reactor,
+    private val targetConfig: TargetConfig,
+    private val fileConfig: CppFileConfig,
+) {
+
+    private val fastParameterParsing = targetConfig.get(FastParameterParsingProperty.INSTANCE)
+
+    fun generateCode() = with(PrependOperator) {
+        """
+        ${" |"..fileComment(main.eResource())}
+            |
+            |#include <chrono>
+            |#include <fstream>
+            |#include <iostream>
+            |#include <memory>
+            |#include <thread>
+        ${" |"..if (fastParameterParsing) "#include <algorithm>\n#include <array>\n#include <charconv>\n#include <string_view>\n#include <vector>" else ""}
+            |
+            |#include "reactor-cpp/reactor-cpp.hh"
+            |
+            |using namespace std::chrono_literals;
+            |using namespace reactor::operators;
+            |
+            |
+            |#include "${fileConfig.getReactorHeaderPath(main).toUnixString()}"
+            |
+            |#include "time_parser.hh"
+            |
+        ${" |"..if (fastParameterParsing) generateFastParameterValueParser() else ""}
+            |
+            |int main(int argc, char **argv) {
+            |  cxxopts::Options options("${fileConfig.name}", "Reactor Benchmark Runner");
+            |
+            |  unsigned workers = ${if (targetConfig.get(WorkersProperty.INSTANCE) != 0) targetConfig.get(WorkersProperty.INSTANCE) else "std::thread::hardware_concurrency()"};
+            |  bool fast{${targetConfig.get(FastProperty.INSTANCE)}};
+            |  reactor::Duration timeout = ${if (targetConfig.isSet(TimeOutProperty.INSTANCE)) targetConfig.get(TimeOutProperty.INSTANCE).toCppCode() else "reactor::Duration::max()"};
+            |  unsigned warmup{3};
+            |  unsigned runs{10};
+            |  std::string output_file{};
+            |
+            |  options
+            |    .set_width(120)
+            |    .add_options()
+            |      ("w,workers", "the number of worker threads used by the scheduler", cxxopts::value<unsigned>(workers)->default_value(std::to_string(workers)), "'unsigned'")
+            |      ("o,timeout", "Time after which the execution is aborted.", cxxopts::value<reactor::Duration>(timeout)->default_value(time_to_string(timeout)), "'FLOAT UNIT'")
+            |      ("f,fast", "Allow logical time to run faster than physical time.", cxxopts::value<bool>(fast)->default_value("${targetConfig.get(FastProperty.INSTANCE)}"))
+            |      ("warmup", "The number of unmeasured warmup iterations.", cxxopts::value<unsigned>(warmup)->default_value("3"), "'unsigned'")
+            |      ("runs", "The number of measured iterations.", cxxopts::value<unsigned>(runs)->default_value("10"), "'unsigned'")
+            |      ("output-file", "Write the JSON results to this file instead of stdout.", cxxopts::value<std::string>(output_file)->default_value(""), "'PATH'")
+            |      ("help", "Print help");
+            |
+        ${" |  "..if (fastParameterParsing) generateFastParameterPrescan(main) else main.parameters.joinToString("\n\n") { generateParameterParser(main, it) }}
+            |
+            |  cxxopts::ParseResult result{};
+            |  bool parse_error{false};
+            |  try {
+            |    result = options.parse(argc, argv);
+            |  } catch (const cxxopts::OptionException& e) {
+            |    reactor::log::Error() << e.what();
+            |    parse_error = true;
+            |  }
+            |${if (fastParameterParsing) "  parse_error = parse_error || __lf_parameter_error;" else ""}
+            |
+            |  // if parameter --help was used or there was a parse error, print help
+            |  if (parse_error || result.count("help"))
+            |  {
+            |       std::cout << options.help({""});
+            |       return parse_error ? -1 : 0;
+            |  }
+            |
+            |  lfutil::Histogram assemble_latency;
+            |  lfutil::Histogram execution_latency;
+            |
+            |  for (unsigned iteration{0}; iteration < warmup + runs; iteration++) {
+            |    reactor::Environment e{workers, fast, timeout};
+            |
+            |    // instantiate the main reactor
+            |    ${generateMainReactorInstantiation(main)}
+            |
+            |    // assemble and execute the reactor program, timing both phases separately
+            |    const auto start = std::chrono::steady_clock::now();
+            |    e.assemble();
+            |    const auto assembled = std::chrono::steady_clock::now();
+            |    auto thread = e.startup();
+            |    thread.join();
+            |    const auto done = std::chrono::steady_clock::now();
+            |
+            |    if (iteration >= warmup) {
+            |      assemble_latency.record(std::chrono::duration_cast<std::chrono::nanoseconds>(assembled - start).count());
+            |      execution_latency.record(std::chrono::duration_cast<std::chrono::nanoseconds>(done - assembled).count());
+            |    }
+            |  }
+            |
+            |  std::ofstream file_out;
+            |  if (!output_file.empty()) {
+            |    file_out.open(output_file);
+            |  }
+            |  std::ostream& out = output_file.empty() ? std::cout : file_out;
+            |
+            |  out << "{\"benchmark\":\"${fileConfig.name}\",\"workers\":" << workers << ",\"warmup\":" << warmup
+            |      << ",\"runs\":" << runs << ",\"assemble_ns\":";
+            |  assemble_latency.write_json(out);
+            |  out << ",\"execution_ns\":";
+            |  execution_latency.write_json(out);
+            |  out << "}" << std::endl;
+            |
+            |  return 0;
+            |}
+        """.trimMargin()
+    }
+}
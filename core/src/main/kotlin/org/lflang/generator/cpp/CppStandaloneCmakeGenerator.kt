@@ -66,6 +66,34 @@ class CppStandaloneCmakeGenerator(private val targetConfig: TargetConfig, privat
             |  endif()
             |endif()
             |
+            |# The ReleasePGO build type is the Release type plus a two-phase profile-guided optimization
+            |# pipeline: configure with -DLF_PGO_PHASE=generate (the default), exercise the instrumented
+            |# binary, build the pgo-merge target, then reconfigure with -DLF_PGO_PHASE=use.
+            |if(CMAKE_BUILD_TYPE STREQUAL "ReleasePGO")
+            |  set(CMAKE_BUILD_TYPE "Release")
+            |  set(LF_PGO ON)
+            |  set(LF_PGO_PHASE "generate" CACHE STRING "Phase of the PGO pipeline, either generate or use.")
+            |  set(LF_PGO_PROFILE_DIR "$S{CMAKE_BINARY_DIR}/pgo-profiles" CACHE PATH "Directory holding the collected profiles.")
+            |  file(MAKE_DIRECTORY "$S{LF_PGO_PROFILE_DIR}")
+            |
+            |  if(CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+            |    if(LF_PGO_PHASE STREQUAL "use")
+            |      set(CMAKE_CXX_FLAGS "$S{CMAKE_CXX_FLAGS} -fprofile-instr-use=$S{LF_PGO_PROFILE_DIR}/merged.profdata")
+            |    else()
+            |      set(CMAKE_CXX_FLAGS "$S{CMAKE_CXX_FLAGS} -fprofile-instr-generate=$S{LF_PGO_PROFILE_DIR}/%p.profraw")
+            |    endif()
+            |  elseif(CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+            |    if(LF_PGO_PHASE STREQUAL "use")
+            |      set(CMAKE_CXX_FLAGS "$S{CMAKE_CXX_FLAGS} -fprofile-use=$S{LF_PGO_PROFILE_DIR} -fprofile-correction")
+            |    else()
+            |      set(CMAKE_CXX_FLAGS "$S{CMAKE_CXX_FLAGS} -fprofile-generate=$S{LF_PGO_PROFILE_DIR}")
+            |    endif()
+            |  else()
+            |    message("Not applying profile-guided optimization since the selected compiler is neither gcc nor clang")
+            |    set(LF_PGO OFF)
+            |  endif()
+            |endif()
+            |
             |# require C++ $CPP_VERSION
             |set(CMAKE_CXX_STANDARD $CPP_VERSION CACHE STRING "The C++ standard is cached for visibility in external tools." FORCE)
             |set(CMAKE_CXX_STANDARD_REQUIRED ON)
@@ -135,6 +163,28 @@ class CppStandaloneCmakeGenerator(private val targetConfig: TargetConfig, privat
         """.trimMargin()
     }
 
+    /**
+     * Generate the unity build setup for the main target, if the unity-build property is set.
+     *
+     * This batches the generated sources into unity translation units and precompiles the
+     * reactor-cpp header, so the runtime headers are parsed once per batch rather than once per
+     * reactor source file. Both features need CMake 3.16; older versions get a regular build.
+     */
+    private fun generateUnityBuild(): String {
+        if (!targetConfig.get(UnityBuildProperty.INSTANCE)) {
+            return ""
+        }
+        return """
+            |if(CMAKE_VERSION VERSION_GREATER_EQUAL "3.16")
+            |  set_target_properties($S{LF_MAIN_TARGET} PROPERTIES UNITY_BUILD ON UNITY_BUILD_BATCH_SIZE 8)
+            |  target_precompile_headers($S{LF_MAIN_TARGET} PRIVATE <reactor-cpp/reactor-cpp.hh>)
+            |else()
+            |  message(WARNING "The unity-build target property requires CMake 3.16 or newer; compiling each source file separately.")
+            |endif()
+            |
+        """.trimMargin()
+    }
+
     fun generateCmake(sources: List<Path>): String {
         // Resolve path to the cmake include files if any was provided
         val includeFiles = (targetConfig.get(CmakeIncludeProperty.INSTANCE) + targetConfig.get(CmakeInitIncludeProperty.INSTANCE))?.map { fileConfig.srcPath.resolve(it).toUnixString() }
@@ -163,6 +213,9 @@ class CppStandaloneCmakeGenerator(private val targetConfig: TargetConfig, privat
                 |    "$S{PROJECT_SOURCE_DIR}/__include__"
                 |)
                 |target_link_libraries($S{LF_MAIN_TARGET} $reactorCppTarget)
+                |${if (targetConfig.get(ValuePoolSizeProperty.INSTANCE) > 0) "target_compile_definitions($S{LF_MAIN_TARGET} PRIVATE LF_VALUE_POOL_SIZE=${targetConfig.get(ValuePoolSizeProperty.INSTANCE)})" else ""}
+                |${if (targetConfig.get(ReactionTracingProperty.INSTANCE)) "target_compile_definitions($S{LF_MAIN_TARGET} PRIVATE LF_REACTION_TRACING=1)" else ""}
+                |${if (targetConfig.get(RuntimeTelemetryProperty.INSTANCE)) "target_compile_definitions($S{LF_MAIN_TARGET} PRIVATE LF_RUNTIME_TELEMETRY=1)" else ""}
                 |
                 |if(MSVC)
                 |  target_compile_options($S{LF_MAIN_TARGET} PRIVATE /W4)
@@ -170,6 +223,44 @@ class CppStandaloneCmakeGenerator(private val targetConfig: TargetConfig, privat
                 |  target_compile_options($S{LF_MAIN_TARGET} PRIVATE -Wall -Wextra -pedantic)
                 |endif()
                 |
+            ${" |"..generateUnityBuild()}
+                |if(LF_PGO)
+                |  # thin link-time optimization for the final binary of both PGO phases
+                |  if(CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+                |    target_compile_options($S{LF_MAIN_TARGET} PRIVATE -flto=thin)
+                |    set_property(TARGET $S{LF_MAIN_TARGET} APPEND_STRING PROPERTY LINK_FLAGS " -flto=thin")
+                |    # clang profiles must be merged explicitly between the generate and use phases.
+                |    # Custom commands run without a shell, so the .profraw files are globbed by a
+                |    # CMake script at build time instead of relying on shell expansion.
+                |    find_program(LLVM_PROFDATA_BIN llvm-profdata)
+                |    if(LLVM_PROFDATA_BIN)
+                |      file(WRITE "$S{CMAKE_BINARY_DIR}/pgo-merge.cmake"
+                |        "file(GLOB profiles \"$S{LF_PGO_PROFILE_DIR}/*.profraw\")\n"
+                |        "if(NOT profiles)\n"
+                |        "  message(FATAL_ERROR \"No .profraw files found in $S{LF_PGO_PROFILE_DIR}. Run the instrumented binary first.\")\n"
+                |        "endif()\n"
+                |        "execute_process(\n"
+                |        "  COMMAND \"$S{LLVM_PROFDATA_BIN}\" merge \"-output=$S{LF_PGO_PROFILE_DIR}/merged.profdata\" \\$S{profiles}\n"
+                |        "  RESULT_VARIABLE result)\n"
+                |        "if(result)\n"
+                |        "  message(FATAL_ERROR \"llvm-profdata merge failed: \\$S{result}\")\n"
+                |        "endif()\n"
+                |      )
+                |      add_custom_target(pgo-merge
+                |        COMMAND $S{CMAKE_COMMAND} -P "$S{CMAKE_BINARY_DIR}/pgo-merge.cmake"
+                |        COMMENT "Merging collected PGO profiles"
+                |      )
+                |    else()
+                |      message("llvm-profdata was not found; the collected profiles must be merged manually")
+                |    endif()
+                |  elseif(CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+                |    target_compile_options($S{LF_MAIN_TARGET} PRIVATE -flto)
+                |    set_property(TARGET $S{LF_MAIN_TARGET} APPEND_STRING PROPERTY LINK_FLAGS " -flto")
+                |    # gcc reads the raw profiles directly, no merge step is needed
+                |    add_custom_target(pgo-merge COMMENT "gcc merges profiles automatically; nothing to do")
+                |  endif()
+                |endif()
+                |
                 |install(TARGETS $S{LF_MAIN_TARGET}
                 |        RUNTIME DESTINATION $S{CMAKE_INSTALL_BINDIR}
                 |        OPTIONAL
@@ -4,6 +4,7 @@ import org.apache.commons.text.StringEscapeUtils
 import org.lflang.generator.CodeMap
 import org.lflang.generator.LFGeneratorContext
 import org.lflang.generator.docker.DockerGenerator
+import org.lflang.target.property.BenchmarkProperty
 import org.lflang.target.property.BuildTypeProperty
 import org.lflang.target.property.CompilerProperty
 import org.lflang.target.property.DockerProperty
@@ -21,8 +22,10 @@ class CppStandaloneGenerator(generator: CppGenerator) :
 
     companion object {
         fun buildTypeToCmakeConfig(type: BuildType) = when (type) {
-            BuildType.TEST -> "Debug"
-            else           -> type.toString()
+            BuildType.TEST        -> "Debug"
+            // the generated CMake remaps ReleasePGO to Release and only adds the PGO flags on top
+            BuildType.RELEASE_PGO -> "Release"
+            else                  -> type.toString()
         }
 
         const val DEFAULT_BASE_IMAGE: String = "alpine:latest"
@@ -32,14 +35,20 @@ class CppStandaloneGenerator(generator: CppGenerator) :
 
         // generate the main source file (containing main())
         val mainFile = Paths.get("main.cc")
-        val mainCodeMap =
-            CodeMap.fromGeneratedCode(
+        val mainCode =
+            if (targetConfig.get(BenchmarkProperty.INSTANCE))
+                CppStandaloneBenchmarkMainGenerator(
+                    mainReactor,
+                    generator.targetConfig,
+                    generator.fileConfig
+                ).generateCode()
+            else
                 CppStandaloneMainGenerator(
                     mainReactor,
                     generator.targetConfig,
                     generator.fileConfig
                 ).generateCode()
-            )
+        val mainCodeMap = CodeMap.fromGeneratedCode(mainCode)
         cppSources.add(mainFile)
         codeMaps[fileConfig.srcGenPath.resolve(mainFile)] = mainCodeMap
         println("Path: $srcGenPath $srcGenPath")
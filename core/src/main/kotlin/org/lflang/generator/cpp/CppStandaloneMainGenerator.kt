@@ -5,10 +5,18 @@ import org.lflang.generator.PrependOperator
 import org.lflang.inferredType
 import org.lflang.lf.Parameter
 import org.lflang.lf.Reactor
+import org.lflang.target.property.CheckpointingProperty
+import org.lflang.target.property.EventQueueProperty
+import org.lflang.target.property.ExecutorProperty
 import org.lflang.target.property.ExportDependencyGraphProperty
+import org.lflang.target.property.FastParameterParsingProperty
 import org.lflang.target.property.FastProperty
+import org.lflang.target.property.MemoryAccountingProperty
+import org.lflang.target.property.RuntimeTelemetryProperty
 import org.lflang.target.property.TimeOutProperty
 import org.lflang.target.property.WorkersProperty
+import org.lflang.target.property.type.EventQueueType.EventQueue
+import org.lflang.target.property.type.ExecutorType.Executor
 import org.lflang.toUnixString
 
 /** C++ code generator responsible for generating the main file including the main() function */
@@ -17,29 +25,164 @@ class CppStandaloneMainGenerator(
     private val targetConfig: TargetConfig,
     private val fileConfig: CppFileConfig,
 ) {
-    // Cxxopts generation
-    private fun generateParameterParser(param: Parameter): String {
-        with(CppParameterGenerator) {
-            with(param) {
-                return if(inferredType.isTime) {
-                    """
-                        $targetType $name${CppTypes.getCppInitializer(init, inferredType)};
-                        options
-                            .add_options()("$name", "The $name parameter passed to the main reactor ${main.name}.", cxxopts::value<$targetType>($name)->default_value(time_to_string($name)), "'FLOAT UNIT'");
-                    """.trimIndent()
-                } else {
-                    """
-                        $targetType $name${CppTypes.getCppInitializer(init, inferredType)};
-                        options
-                            .add_options()("$name", "The $name parameter passed to the main reactor ${main.name}.", cxxopts::value<$targetType>($name)->default_value(any_to_string($name)), "'$targetType'");
-                    """.trimIndent()
+    companion object {
+        // Cxxopts generation
+        internal fun generateParameterParser(main: Reactor, param: Parameter): String {
+            with(CppParameterGenerator) {
+                with(param) {
+                    return if(inferredType.isTime) {
+                        """
+                            $targetType $name${CppTypes.getCppInitializer(init, inferredType)};
+                            options
+                                .add_options()("$name", "The $name parameter passed to the main reactor ${main.name}.", cxxopts::value<$targetType>($name)->default_value(time_to_string($name)), "'FLOAT UNIT'");
+                        """.trimIndent()
+                    } else {
+                        """
+                            $targetType $name${CppTypes.getCppInitializer(init, inferredType)};
+                            options
+                                .add_options()("$name", "The $name parameter passed to the main reactor ${main.name}.", cxxopts::value<$targetType>($name)->default_value(any_to_string($name)), "'$targetType'");
+                        """.trimIndent()
+                    }
                 }
             }
         }
+
+        private fun generateMainReactorExpression(main: Reactor): String =
+                """std ::make_unique<${main.name}> ("${main.name}", &e, ${main.name}::Parameters{${main.parameters.joinToString(", ") { ".${it.name} = ${it.name}" }}})"""
+
+        internal fun generateMainReactorInstantiation(main: Reactor): String =
+                """auto main = ${generateMainReactorExpression(main)};"""
+
+        /** Instantiate the main reactor inside an accounting scope, attributing its allocations to its name. */
+        internal fun generateAccountedMainReactorInstantiation(main: Reactor): String =
+                """auto main = lfutil::memory::scoped_construct("${main.name}", [&]() { return ${generateMainReactorExpression(main)}; });"""
+
+        /** Replacements for the global allocation functions, routing through the accounting allocator. */
+        internal fun generateAccountingOperators() = """
+            // accounting allocator: attribute every allocation to the reactor scope that made it
+            void* operator new(std::size_t size) { return lfutil::memory::allocate(size); }
+            void operator delete(void* ptr) noexcept { lfutil::memory::deallocate(ptr); }
+            void operator delete(void* ptr, std::size_t) noexcept { lfutil::memory::deallocate(ptr); }
+        """.trimIndent()
+
+        /**
+         * A type-directed value parser used by the fast parameter parsing mode.
+         *
+         * Unlike the cxxopts path, this never round-trips values through a stringstream for the
+         * common parameter types. The stream-based fallback only remains for user-defined types
+         * that provide an `operator>>`.
+         */
+        internal fun generateFastParameterValueParser() = """
+            template <class T>
+            bool __lf_parse_value(std::string_view text, T& out) {
+              if constexpr (std::is_same_v<T, reactor::Duration>) {
+                return parse_duration(text, out).empty();
+              } else if constexpr (std::is_same_v<T, bool>) {
+                if (text == "true" || text == "1") { out = true; return true; }
+                if (text == "false" || text == "0") { out = false; return true; }
+                return false;
+              } else if constexpr (std::is_arithmetic_v<T>) {
+                const char* last = text.data() + text.size();
+                auto [ptr, ec] = std::from_chars(text.data(), last, out);
+                return ec == std::errc{} && ptr == last;
+              } else if constexpr (std::is_assignable_v<T&, std::string_view>) {
+                out = text;
+                return true;
+              } else {
+                std::stringstream stream{std::string{text}};
+                stream >> out;
+                return !stream.fail();
+              }
+            }
+        """.trimIndent()
+
+        /**
+         * Generate the fast replacement for the per-parameter cxxopts registrations.
+         *
+         * Main-reactor parameters are matched against a sorted compile-time name table and their
+         * values are parsed in place with [generateFastParameterValueParser]'s `__lf_parse_value`.
+         * Matched arguments are consumed; everything else is forwarded to cxxopts by rewriting
+         * `argc`/`argv`. Parse failures are collected in `__lf_parameter_error`.
+         */
+        internal fun generateFastParameterPrescan(main: Reactor): String {
+            val declarations = main.parameters.joinToString("\n") {
+                with(CppParameterGenerator) { "${it.targetType} ${it.name}${CppTypes.getCppInitializer(it.init, it.inferredType)};" }
+            }
+            if (main.parameters.isEmpty()) {
+                return "bool __lf_parameter_error{false};"
+            }
+            val sorted = main.parameters.sortedBy { it.name }
+            val names = sorted.joinToString(", ") { "\"${it.name}\"" }
+            val isBool = sorted.joinToString(", ") {
+                with(CppParameterGenerator) { if (it.targetType == "bool") "true" else "false" }
+            }
+            val cases = sorted.mapIndexed { index, param ->
+                "case $index: return __lf_parse_value(value, ${param.name});"
+            }.joinToString("\n    ")
+            return with(PrependOperator) {
+                """
+                    ${" |"..declarations}
+                        |
+                        |// parameters passed to the main reactor, sorted for binary search
+                        |constexpr std::array<std::string_view, ${main.parameters.size}> __lf_parameter_names{$names};
+                        |constexpr std::array<bool, ${main.parameters.size}> __lf_parameter_is_bool{$isBool};
+                        |const auto __lf_parse_parameter = [&](std::size_t index, std::string_view value) -> bool {
+                        |  switch (index) {
+                        |    $cases
+                        |    default: return false;
+                        |  }
+                        |};
+                        |
+                        |// consume all main reactor parameters and forward the remaining arguments to cxxopts
+                        |bool __lf_parameter_error{false};
+                        |std::vector<char*> __lf_args;
+                        |__lf_args.reserve(static_cast<std::size_t>(argc));
+                        |__lf_args.push_back(argv[0]);
+                        |for (int i = 1; i < argc; i++) {
+                        |  const std::string_view arg{argv[i]};
+                        |  if (arg.size() <= 2 || arg.compare(0, 2, "--") != 0) {
+                        |    __lf_args.push_back(argv[i]);
+                        |    continue;
+                        |  }
+                        |  const auto eq = arg.find('=');
+                        |  const auto name = arg.substr(2, eq == std::string_view::npos ? std::string_view::npos : eq - 2);
+                        |  const auto it = std::lower_bound(__lf_parameter_names.begin(), __lf_parameter_names.end(), name);
+                        |  if (it == __lf_parameter_names.end() || *it != name) {
+                        |    __lf_args.push_back(argv[i]);
+                        |    continue;
+                        |  }
+                        |  const auto index = static_cast<std::size_t>(it - __lf_parameter_names.begin());
+                        |  std::string_view value;
+                        |  if (eq != std::string_view::npos) {
+                        |    value = arg.substr(eq + 1);
+                        |  } else if (__lf_parameter_is_bool[index]) {
+                        |    // flag-style booleans get an implicit value, just like in cxxopts
+                        |    value = "true";
+                        |  } else if (i + 1 < argc) {
+                        |    value = argv[++i];
+                        |  } else {
+                        |    reactor::log::Error() << "Missing value for parameter --" << name;
+                        |    __lf_parameter_error = true;
+                        |    continue;
+                        |  }
+                        |  if (!__lf_parse_parameter(index, value)) {
+                        |    reactor::log::Error() << "Invalid value '" << value << "' for parameter --" << name;
+                        |    __lf_parameter_error = true;
+                        |  }
+                        |}
+                        |argc = static_cast<int>(__lf_args.size());
+                        |argv = __lf_args.data();
+                """.trimMargin()
+            }
+        }
     }
 
-    private fun generateMainReactorInstantiation(): String =
-            """auto main = std ::make_unique<${main.name}> ("${main.name}", &e, ${main.name}::Parameters{${main.parameters.joinToString(", ") { ".${it.name} = ${it.name}" }}});"""
+    private val checkpointing = targetConfig.get(CheckpointingProperty.INSTANCE)
+    private val memoryAccounting = targetConfig.get(MemoryAccountingProperty.INSTANCE)
+    private val fastParameterParsing = targetConfig.get(FastParameterParsingProperty.INSTANCE)
+    private val runtimeTelemetry = targetConfig.get(RuntimeTelemetryProperty.INSTANCE)
+    private val executor = targetConfig.get(ExecutorProperty.INSTANCE)
+    private val eventQueue = targetConfig.get(EventQueueProperty.INSTANCE)
 
     fun generateCode() = with(PrependOperator) {
         """
@@ -48,6 +191,7 @@ class CppStandaloneMainGenerator(
             |#include <chrono>
             |#include <thread>
             |#include <memory>
+        ${" |"..if (fastParameterParsing) "#include <algorithm>\n#include <array>\n#include <charconv>\n#include <string_view>\n#include <vector>" else ""}
             |
             |#include "reactor-cpp/reactor-cpp.hh"
             |
@@ -59,13 +203,25 @@ class CppStandaloneMainGenerator(
             |
             |#include "time_parser.hh"
             |
+        ${" |"..if (memoryAccounting) generateAccountingOperators() else ""}
+            |
+        ${" |"..if (fastParameterParsing) generateFastParameterValueParser() else ""}
+            |
             |int main(int argc, char **argv) {
             |  cxxopts::Options options("${fileConfig.name}", "Reactor Program");
             |
             |  unsigned workers = ${if (targetConfig.get(WorkersProperty.INSTANCE) != 0) targetConfig.get(WorkersProperty.INSTANCE) else "std::thread::hardware_concurrency()"};
             |  bool fast{${targetConfig.get(FastProperty.INSTANCE)}};
             |  reactor::Duration timeout = ${if (targetConfig.isSet(TimeOutProperty.INSTANCE)) targetConfig.get(TimeOutProperty.INSTANCE).toCppCode() else "reactor::Duration::max()"};
-            |  
+            |  bool pin_workers{false};
+            |  int numa_node{-1};
+            |  std::string worker_cpus{};
+            |  std::string scheduler{"$executor"};
+            |  std::string event_queue{"$eventQueue"};
+            |${if (runtimeTelemetry) "  unsigned short metrics_port{0};" else ""}
+            |${if (checkpointing) "  std::string checkpoint_to{};\n  std::string restore_from{};" else ""}
+            |${if (memoryAccounting) "  bool dump_memory_stats{false};" else ""}
+            |
             |  // the timeout variable needs to be tested beyond fitting the Duration-type 
             |  options
             |    .set_width(120)
@@ -73,9 +229,18 @@ class CppStandaloneMainGenerator(
             |      ("w,workers", "the number of worker threads used by the scheduler", cxxopts::value<unsigned>(workers)->default_value(std::to_string(workers)), "'unsigned'")
             |      ("o,timeout", "Time after which the execution is aborted.", cxxopts::value<reactor::Duration>(timeout)->default_value(time_to_string(timeout)), "'FLOAT UNIT'")
             |      ("f,fast", "Allow logical time to run faster than physical time.", cxxopts::value<bool>(fast)->default_value("${targetConfig.get(FastProperty.INSTANCE)}"))
+            |      ("pin-workers", "Narrow the CPU mask shared by all worker threads to one CPU per worker. The OS still places the threads within the mask.", cxxopts::value<bool>(pin_workers)->default_value("false"))
+            |      ("numa-node", "Restrict all worker threads to the CPUs of the given NUMA node.", cxxopts::value<int>(numa_node)->default_value("-1"), "'int'")
+            |      ("scheduler", "The scheduling policy. This binary was configured with '$executor'; other policies require a rebuild.", cxxopts::value<std::string>(scheduler)->default_value("$executor"), "'POLICY'")
+            |      ("event-queue", "The event queue structure. This binary was configured with '$eventQueue'; other structures require a rebuild.", cxxopts::value<std::string>(event_queue)->default_value("$eventQueue"), "'QUEUE'")
+            |      ("worker-cpus", "Restrict the CPU mask shared by all worker threads to these CPUs.", cxxopts::value<std::string>(worker_cpus)->default_value(""), "'CPU,...'")
+            |${if (runtimeTelemetry)"""      ("metrics-port", "Serve live telemetry counter snapshots on this loopback TCP port.", cxxopts::value<unsigned short>(metrics_port)->default_value("0"), "'port'")""" else ""}
+            |${if (checkpointing)"""      ("checkpoint-to", "Write a snapshot of all reactor state to this file after execution finishes.", cxxopts::value<std::string>(checkpoint_to)->default_value(""), "'FILE'")
+            |      ("restore-from", "Restore all reactor state from the given snapshot before execution starts.", cxxopts::value<std::string>(restore_from)->default_value(""), "'FILE'")""" else ""}
+            |${if (memoryAccounting)"""      ("dump-memory-stats", "Print live bytes and allocation counts per reactor at shutdown.", cxxopts::value<bool>(dump_memory_stats)->default_value("false"))""" else ""}
             |      ("help", "Print help");
             |      
-        ${" |"..main.parameters.joinToString("\n\n") { generateParameterParser(it) }}
+        ${" |  "..if (fastParameterParsing) generateFastParameterPrescan(main) else main.parameters.joinToString("\n\n") { generateParameterParser(main, it) }}
             |
             |  cxxopts::ParseResult result{};
             |  bool parse_error{false};
@@ -85,7 +250,8 @@ class CppStandaloneMainGenerator(
             |    reactor::log::Error() << e.what();
             |    parse_error = true;
             |  }
-            |  
+            |${if (fastParameterParsing) "  parse_error = parse_error || __lf_parameter_error;" else ""}
+            |
             |  // if parameter --help was used or there was a parse error, print help
             |  if (parse_error || result.count("help"))
             |  {
@@ -93,10 +259,54 @@ class CppStandaloneMainGenerator(
             |       return parse_error ? -1 : 0;
             |  }
             |
+            |  // the scheduling policy is fixed at build time and cannot change at startup
+            |  if (scheduler != "$executor") {
+            |    reactor::log::Error() << "This binary was configured with the '$executor' scheduler policy. "
+            |                          << "Set the scheduler target property to '" << scheduler << "' and rebuild to use it.";
+            |    return -1;
+            |  }
+        ${" |  "..if (executor != Executor.DEFAULT) """
+            |// REACTOR_CPP_SCHEDULER is recorded in the build configuration, but the runtime version
+            |// pinned by this compiler does not select a scheduler from it yet
+            |reactor::log::Warn() << "The '$executor' scheduler policy was requested at build time, but the "
+            |                     << "bundled runtime does not implement policy selection; running with the "
+            |                     << "runtime's default scheduler.";""".trimMargin() else ""}
+            |
+            |  // the event queue structure is fixed at build time and cannot change at startup
+            |  if (event_queue != "$eventQueue") {
+            |    reactor::log::Error() << "This binary was configured with the '$eventQueue' event queue. "
+            |                          << "Set the event-queue target property to '" << event_queue << "' and rebuild to use it.";
+            |    return -1;
+            |  }
+        ${" |  "..if (eventQueue != EventQueue.DEFAULT) """
+            |// REACTOR_CPP_EVENT_QUEUE is recorded in the build configuration, but the runtime version
+            |// pinned by this compiler does not select a queue structure from it yet
+            |reactor::log::Warn() << "The '$eventQueue' event queue was requested at build time, but the "
+            |                     << "bundled runtime does not implement queue selection; running with the "
+            |                     << "runtime's default event queue.";""".trimMargin() else ""}
+            |
+            |  // restrict the CPUs available to the scheduler's workers before any of them is spawned
+            |  lfutil::apply_worker_affinity(workers, pin_workers, numa_node, worker_cpus);
+            |
+        ${" |  "..if (runtimeTelemetry) """
+            |if (metrics_port != 0) {
+            |  lfutil::telemetry::start_metrics_server(metrics_port);
+            |}""".trimMargin() else ""}
+            |
             |  reactor::Environment e{workers, fast, timeout};
             |
             |  // instantiate the main reactor
-            |  ${generateMainReactorInstantiation()}
+            |  ${if (memoryAccounting) generateAccountedMainReactorInstantiation(main) else generateMainReactorInstantiation(main)}
+            |
+        ${" |  "..if (checkpointing) """
+            |if (!restore_from.empty()) {
+            |  lfutil::checkpoint::Reader reader{restore_from};
+            |  main->__lf_checkpoint_restore(reader);
+            |  if (!reader.ok()) {
+            |    reactor::log::Error() << "Failed to restore state from '" << restore_from << "'";
+            |    return -1;
+            |  }
+            |}""".trimMargin() else ""}
             |
             |  // assemble reactor program
             |  e.assemble();
@@ -104,6 +314,18 @@ class CppStandaloneMainGenerator(
             |  // start execution
             |  auto thread = e.startup();
             |  thread.join();
+        ${" |  "..if (checkpointing) """
+            |if (!checkpoint_to.empty()) {
+            |  lfutil::checkpoint::Writer writer{checkpoint_to};
+            |  main->__lf_checkpoint_save(writer);
+            |  if (!writer.ok()) {
+            |    reactor::log::Warn() << "Failed to write checkpoint to '" << checkpoint_to << "'";
+            |  }
+            |}""".trimMargin() else ""}
+        ${" |  "..if (memoryAccounting) """
+            |if (dump_memory_stats) {
+            |  lfutil::memory::Registry::instance().dump(std::cerr);
+            |}""".trimMargin() else ""}
         ${" |".. if (targetConfig.get(ExportDependencyGraphProperty.INSTANCE)) "e.export_dependency_graph(\"${main.name}.dot\");" else ""}
             |  return 0;
             |}
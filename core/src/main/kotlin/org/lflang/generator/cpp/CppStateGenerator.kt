@@ -24,6 +24,7 @@
 
 package org.lflang.generator.cpp
 
+import org.lflang.generator.PrependOperator
 import org.lflang.inferredType
 import org.lflang.isInitialized
 import org.lflang.joinWithLn
@@ -44,4 +45,17 @@ class CppStateGenerator(private val reactor: Reactor) {
             .joinWithLn(prefix = "// state variables\n") {
                 ", " + it.name + CppTypes.getCppInitializer(it.init, it.inferredType, disableEquals = true)
             }
+
+    /** Generate methods that save and restore all state variables through a checkpoint file. */
+    fun generateCheckpointMethods() = with(PrependOperator) {
+        """
+            |// checkpointing
+            |void __lf_checkpoint_save(lfutil::checkpoint::Writer& writer) const {
+        ${" |  "..reactor.stateVars.joinWithLn { "writer.save(${it.name});" }}
+            |}
+            |void __lf_checkpoint_restore(lfutil::checkpoint::Reader& reader) {
+        ${" |  "..reactor.stateVars.joinWithLn { "reader.restore(${it.name});" }}
+            |}
+        """.trimMargin()
+    }
 }
@@ -27,11 +27,53 @@ package org.lflang.generator.cpp
 import org.lflang.generator.orZero
 import org.lflang.lf.Reactor
 import org.lflang.lf.Timer
+import org.lflang.lf.VarRef
+import org.lflang.target.TargetConfig
+import org.lflang.target.property.CoalesceTimersProperty
 
 /** A C++ code generator for timers */
-class CppTimerGenerator(private val reactor: Reactor) {
+class CppTimerGenerator(private val reactor: Reactor, targetConfig: TargetConfig) {
+
+    /**
+     * Map each coalesced timer to the timer whose reactor::Timer instance it shares.
+     *
+     * Timers with identical offset and period fire at exactly the same tags, so with the
+     * coalesce-timers target property all but the first timer of such a group become references to
+     * the first one, collapsing their event queue entries into a single one. A group is left alone
+     * if any reaction is triggered by more than one of its timers, since that reaction would
+     * otherwise declare the same trigger twice.
+     */
+    private val aliasOf: Map<Timer, Timer> =
+        if (!targetConfig.get(CoalesceTimersProperty.INSTANCE)) emptyMap()
+        else computeAliases()
+
+    private fun computeAliases(): Map<Timer, Timer> {
+        val groups = reactor.timers.groupBy { Pair(it.offset.orZero().toCppTime(), it.period.orZero().toCppTime()) }
+        val aliases = mutableMapOf<Timer, Timer>()
+        for (group in groups.values) {
+            if (group.size < 2) continue
+            val conflict = reactor.reactions.any { reaction ->
+                reaction.triggers.count { (it as? VarRef)?.variable in group } > 1
+            }
+            if (conflict) continue
+            for (timer in group.drop(1)) {
+                aliases[timer] = group.first()
+            }
+        }
+        return aliases
+    }
+
+    private fun generateDeclaration(timer: Timer): String {
+        val leader = aliasOf[timer]
+        return if (leader != null) "reactor::Timer& ${timer.name}; // coalesced with ${leader.name}"
+        else "reactor::Timer ${timer.name};"
+    }
 
     private fun generateInitializer(timer: Timer): String {
+        val leader = aliasOf[timer]
+        if (leader != null) {
+            return "${timer.name}{${leader.name}}"
+        }
         val offset = timer.offset.orZero().toCppTime()
         val period = timer.period.orZero().toCppTime()
         return """${timer.name}{"${timer.name}", this, $period, $offset}"""
@@ -39,7 +81,7 @@ class CppTimerGenerator(private val reactor: Reactor) {
 
     /** Get all timer declarations */
     fun generateDeclarations() =
-        reactor.timers.joinToString(separator = "\n", prefix = "// timers\n", postfix = "\n") { "reactor::Timer ${it.name};" }
+        reactor.timers.joinToString(separator = "\n", prefix = "// timers\n", postfix = "\n") { generateDeclaration(it) }
 
     /** Get all timer initializers */
     fun generateInitializers() =
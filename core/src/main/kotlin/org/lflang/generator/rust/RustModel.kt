@@ -726,6 +726,7 @@ val BuildType.cargoProfileName: String
         BuildType.DEBUG             -> "debug"
         BuildType.TEST              -> "lf-test"
         BuildType.RELEASE           -> "release"
+        BuildType.RELEASE_PGO       -> "release"
         BuildType.REL_WITH_DEB_INFO -> "release-with-debug-info"
         BuildType.MIN_SIZE_REL      -> "release-with-min-size"
     }
@@ -27,24 +27,860 @@
 #include <reactor-cpp/logging.hh>
 #include <reactor-cpp/reactor-cpp.hh>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef LF_REACTION_TRACING
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <thread>
+#endif
+
+#ifdef LF_RUNTIME_TELEMETRY
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#if defined(__linux__)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+#endif
+
+// The number of value blocks each worker thread keeps in its local free list. This is set via the
+// value-pool-size target property and defaults to 0, which disables pooling entirely.
+#ifndef LF_VALUE_POOL_SIZE
+#define LF_VALUE_POOL_SIZE 0
+#endif
+
 namespace lfutil {
 
-template <class T> void after_delay(reactor::Action<T>* action, const reactor::Port<T>* port) {
-  if constexpr (std::is_void<T>::value) {
-    action->schedule();
+/**
+ * A per-worker pool of fixed-size storage blocks for message values.
+ *
+ * Each worker thread owns a private free list, so neither allocation nor deallocation requires
+ * synchronization. Blocks released on a different thread than they were allocated on simply join
+ * that thread's free list; every list is bounded by LF_VALUE_POOL_SIZE blocks and overflowing
+ * blocks are returned to the heap.
+ */
+template <class T> class ValuePool {
+private:
+  std::vector<void*> free_blocks_;
+
+  ValuePool() { free_blocks_.reserve(LF_VALUE_POOL_SIZE); }
+
+public:
+  ValuePool(const ValuePool&) = delete;
+  ValuePool& operator=(const ValuePool&) = delete;
+
+  ~ValuePool() {
+    for (void* block : free_blocks_) {
+      ::operator delete(block);
+    }
+  }
+
+  static ValuePool& get() {
+    thread_local ValuePool pool;
+    return pool;
+  }
+
+  void* allocate() {
+    if (!free_blocks_.empty()) {
+      void* block = free_blocks_.back();
+      free_blocks_.pop_back();
+      return block;
+    }
+    return ::operator new(sizeof(T));
+  }
+
+  void deallocate(void* block) {
+    if (free_blocks_.size() < LF_VALUE_POOL_SIZE) {
+      free_blocks_.push_back(block);
+    } else {
+      ::operator delete(block);
+    }
+  }
+};
+
+/** A minimal allocator that serves single-object allocations from the worker-local ValuePool. */
+template <class T> struct PoolAllocator {
+  using value_type = T;
+
+  PoolAllocator() noexcept = default;
+  template <class U>
+  PoolAllocator(const PoolAllocator<U>&) noexcept {} // NOLINT(google-explicit-constructor)
+
+  T* allocate(std::size_t count) {
+    if (count == 1) {
+      return static_cast<T*>(ValuePool<T>::get().allocate());
+    }
+    return static_cast<T*>(::operator new(count * sizeof(T)));
+  }
+
+  void deallocate(T* ptr, std::size_t count) {
+    if (count == 1) {
+      ValuePool<T>::get().deallocate(ptr);
+    } else {
+      ::operator delete(ptr);
+    }
+  }
+};
+
+template <class T, class U> bool operator==(const PoolAllocator<T>&, const PoolAllocator<U>&) { return true; }
+template <class T, class U> bool operator!=(const PoolAllocator<T>&, const PoolAllocator<U>&) { return false; }
+
+/**
+ * Create an immutable message value, drawing its storage from the worker-local value pool.
+ *
+ * This is a drop-in replacement for reactor::make_immutable_value that avoids touching the
+ * general-purpose heap in steady state. If pooling is disabled (LF_VALUE_POOL_SIZE == 0), this
+ * falls back to a plain heap allocation.
+ *
+ * The pool is opt-in at the call site: generated code does not reroute plain set() or schedule()
+ * calls, which keep allocating through the runtime. Reaction bodies that want pooling construct
+ * the value here explicitly and pass the pointer on, e.g.
+ * `out.set(lfutil::make_pooled_value<int>(42))`.
+ */
+template <class T, class... Args> reactor::ImmutableValuePtr<T> make_pooled_value(Args&&... args) {
+  if constexpr (LF_VALUE_POOL_SIZE > 0) {
+    return std::allocate_shared<T>(PoolAllocator<T>{}, std::forward<Args>(args)...);
   } else {
-    action->schedule(std::move(port->get()));
+    return reactor::make_immutable_value<T>(std::forward<Args>(args)...);
   }
 }
 
-template <class T> void after_forward(const reactor::Action<T>* action, reactor::Port<T>* port) {
-  if constexpr (std::is_void<T>::value) {
-    port->set();
+/**
+ * A fixed-size log-linear histogram in the style of HDR histograms.
+ *
+ * Values are sorted into buckets with a relative precision of 1/16th, so recording is a handful
+ * of bit operations and never allocates, which makes the histogram safe to use on hot paths.
+ * Percentiles are reconstructed from the bucket boundaries on demand.
+ */
+class Histogram {
+private:
+  static constexpr unsigned sub_bucket_bits{4};
+  static constexpr std::uint64_t sub_buckets{1ULL << sub_bucket_bits};
+
+  std::array<std::uint64_t, (64 - sub_bucket_bits + 1) * sub_buckets> buckets_{};
+  std::uint64_t count_{0};
+  std::uint64_t sum_{0};
+  std::uint64_t min_{std::numeric_limits<std::uint64_t>::max()};
+  std::uint64_t max_{0};
+
+  static std::size_t bucket_index(std::uint64_t value) {
+    const auto msb = 63U - static_cast<unsigned>(std::countl_zero(value | 1U));
+    if (msb < sub_bucket_bits) {
+      return value;
+    }
+    const auto group = msb - sub_bucket_bits + 1;
+    const auto sub = (value >> (msb - sub_bucket_bits)) & (sub_buckets - 1);
+    return group * sub_buckets + sub;
+  }
+
+  static std::uint64_t bucket_value(std::size_t index) {
+    const auto group = index / sub_buckets;
+    const auto sub = index % sub_buckets;
+    if (group == 0) {
+      return sub;
+    }
+    return (sub_buckets + sub) << (group - 1);
+  }
+
+public:
+  void record(std::uint64_t value) {
+    buckets_[bucket_index(value)]++;
+    count_++;
+    sum_ += value;
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+  }
+
+  [[nodiscard]] std::uint64_t count() const noexcept { return count_; }
+  [[nodiscard]] std::uint64_t min() const noexcept { return count_ == 0 ? 0 : min_; }
+  [[nodiscard]] std::uint64_t max() const noexcept { return max_; }
+  [[nodiscard]] double mean() const noexcept {
+    return count_ == 0 ? 0.0 : static_cast<double>(sum_) / static_cast<double>(count_);
+  }
+
+  /** Get the approximate value at the given percentile (a fraction between 0 and 1). */
+  [[nodiscard]] std::uint64_t percentile(double fraction) const {
+    const auto threshold = static_cast<std::uint64_t>(fraction * static_cast<double>(count_));
+    std::uint64_t seen{0};
+    for (std::size_t index{0}; index < buckets_.size(); index++) {
+      seen += buckets_[index];
+      if (count_ > 0 && seen >= threshold && buckets_[index] > 0) {
+        return bucket_value(index);
+      }
+    }
+    return max_;
+  }
+
+  /** Write the summary statistics as a JSON object. */
+  void write_json(std::ostream& out) const {
+    out << "{\"count\":" << count() << ",\"min\":" << min() << ",\"mean\":" << mean() << ",\"max\":" << max()
+        << ",\"p50\":" << percentile(0.5) << ",\"p90\":" << percentile(0.9) << ",\"p99\":" << percentile(0.99)
+        << "}";
+  }
+};
+
+/** A deleter that runs the destructor but leaves the memory to the owning BankStorage. */
+template <class T> struct destroy_only {
+  void operator()(T* ptr) const { ptr->~T(); }
+};
+
+/** An owning pointer to a bank member that lives inside a BankStorage arena. */
+template <class T> using arena_ptr = std::unique_ptr<T, destroy_only<T>>;
+
+/**
+ * A contiguous storage arena holding all members of a reactor bank in place.
+ *
+ * With the contiguous-banks target property, the generated code reserves one arena per bank and
+ * placement-constructs the members into it in declaration order, so walking a bank touches
+ * sequential cache lines instead of one scattered heap allocation per member. Members are
+ * destroyed through their arena_ptrs (which the generated reactor class declares after the
+ * arena), and the arena merely releases the raw storage afterwards.
+ */
+template <class T> class BankStorage {
+private:
+  T* data_{nullptr};
+  std::size_t size_{0};
+
+public:
+  BankStorage() = default;
+  BankStorage(const BankStorage&) = delete;
+  BankStorage& operator=(const BankStorage&) = delete;
+
+  ~BankStorage() { ::operator delete(data_, std::align_val_t{alignof(T)}); }
+
+  /** Allocate raw storage for the given number of members. */
+  void reserve(std::size_t capacity) {
+    data_ = static_cast<T*>(::operator new(capacity * sizeof(T), std::align_val_t{alignof(T)}));
+  }
+
+  /** Construct the next bank member in place. */
+  template <class... Args> arena_ptr<T> emplace(Args&&... args) {
+    T* slot = data_ + size_;
+    size_++;
+    return arena_ptr<T>{new (slot) T(std::forward<Args>(args)...)};
+  }
+};
+
+/**
+ * A lock-free single-producer single-consumer channel for enclave-to-enclave communication.
+ *
+ * Values travel through a fixed-size ring buffer, so steady-state transfer is one release store
+ * plus a full fence on the producer side and one acquire load on the consumer side — no locks
+ * and no allocations.
+ * Wakeups are batched: the producer only touches the condition variable when the consumer has
+ * announced that it is about to sleep, and the consumer drains the entire backlog per wakeup
+ * instead of being notified once per value.
+ */
+template <class T, std::size_t Capacity = 1024> class SpscChannel {
+  static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+private:
+  std::array<T, Capacity> buffer_{};
+  alignas(64) std::atomic<std::size_t> head_{0};
+  alignas(64) std::atomic<std::size_t> tail_{0};
+  alignas(64) std::atomic<bool> consumer_waiting_{false};
+  std::mutex mutex_;
+  std::condition_variable cv_;
+
+  void notify() {
+    // pairs with the fence in wait(): without it the producer's tail store and waiting-flag read
+    // may reorder against the consumer's flag store and tail read, so the producer could see no
+    // waiter while the consumer sees an empty channel and sleeps on queued data
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (consumer_waiting_.exchange(false, std::memory_order_acq_rel)) {
+      {
+        // the lock pairs with the consumer's sleep check; it is never taken on the fast path
+        std::lock_guard<std::mutex> lock{mutex_};
+      }
+      cv_.notify_one();
+    }
+  }
+
+public:
+  /** Try to push a value without blocking. Returns false if the channel is full. */
+  bool try_push(T&& value) {
+    const auto tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) == Capacity) {
+      return false;
+    }
+    buffer_[tail & (Capacity - 1)] = std::move(value);
+    tail_.store(tail + 1, std::memory_order_release);
+    notify();
+    return true;
+  }
+
+  /** Drain all currently buffered values into the given sink. Returns the number of values. */
+  template <class Sink> std::size_t pop_all(Sink&& sink) {
+    const auto head = head_.load(std::memory_order_relaxed);
+    const auto tail = tail_.load(std::memory_order_acquire);
+    for (auto i = head; i != tail; i++) {
+      sink(std::move(buffer_[i & (Capacity - 1)]));
+    }
+    head_.store(tail, std::memory_order_release);
+    return tail - head;
+  }
+
+  /** Block the consumer until at least one value is available. */
+  void wait() {
+    if (tail_.load(std::memory_order_acquire) != head_.load(std::memory_order_relaxed)) {
+      return;
+    }
+    std::unique_lock<std::mutex> lock{mutex_};
+    consumer_waiting_.store(true, std::memory_order_release);
+    cv_.wait(lock, [this]() {
+      // pairs with the fence in notify(); see there for the store-load race this prevents
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      return tail_.load(std::memory_order_acquire) != head_.load(std::memory_order_relaxed);
+    });
+    consumer_waiting_.store(false, std::memory_order_release);
+  }
+};
+
+/**
+ * A reusable contiguous buffer of values gathered from scattered ports.
+ *
+ * Reactions that reduce over a wide multiport or a bank of contained ports chase a heap pointer
+ * per element on every access. Gathering the present values into a ValueBuffer once at the top of
+ * the reaction body turns the hot loop into a linear scan over contiguous memory. The internal
+ * storage is reused across gathers, so steady-state operation performs no allocations.
+ */
+template <class T> class ValueBuffer {
+private:
+  std::vector<T> values_;
+
+  template <class Element> static auto& as_port(Element& element) {
+    if constexpr (std::is_pointer_v<std::remove_reference_t<Element>>) {
+      return *element;
+    } else {
+      return element;
+    }
+  }
+
+public:
+  /** Gather the values of all present ports in the given range of ports or port pointers. */
+  template <class Ports> std::size_t gather(Ports& ports) {
+    return gather(ports, [](auto& element) -> auto& { return as_port(element); });
+  }
+
+  /**
+   * Gather port values from a range of reaction views, such as a bank of contained reactors. The
+   * accessor selects the port within each view:
+   *
+   *   buffer.gather(bank, [](auto& view) -> auto& { return view.out; });
+   */
+  template <class Views, class Accessor> std::size_t gather(Views& views, Accessor&& accessor) {
+    values_.clear();
+    if (values_.capacity() < std::size(views)) {
+      values_.reserve(std::size(views));
+    }
+    for (auto& view : views) {
+      auto& port = accessor(view);
+      if (port.is_present()) {
+        values_.push_back(*port.get());
+      }
+    }
+    return values_.size();
+  }
+
+  [[nodiscard]] const std::vector<T>& values() const noexcept { return values_; }
+  [[nodiscard]] std::size_t size() const noexcept { return values_.size(); }
+  [[nodiscard]] bool empty() const noexcept { return values_.empty(); }
+  const T& operator[](std::size_t index) const { return values_[index]; }
+  auto begin() const noexcept { return values_.begin(); }
+  auto end() const noexcept { return values_.end(); }
+};
+
+/**
+ * A structure-of-arrays snapshot of a multiport.
+ *
+ * Unlike ValueBuffer, which compacts the present values, a SoaView is positional: channel i of the
+ * multiport maps to index i of one contiguous value array, with presence tracked in a companion
+ * bitmask. Numeric reductions over wide multiports thus become vectorizable linear loops, and code
+ * that needs to know which channel a value came from can still consult the mask. Absent channels
+ * hold a default-constructed value. The internal storage is reused across loads, so steady-state
+ * operation performs no allocations.
+ */
+template <class T> class SoaView {
+  static_assert(std::is_default_constructible_v<T> && std::is_copy_assignable_v<T>,
+                "SoaView requires a value type that can be default-constructed and copied");
+
+private:
+  std::vector<T> values_;
+  std::vector<std::uint64_t> present_;
+
+public:
+  /** Take a positional snapshot of the given multiport's values and presence flags. */
+  template <class Multiport> void load(const Multiport& multiport) {
+    const auto size = std::size(multiport);
+    values_.assign(size, T{});
+    present_.assign((size + 63) / 64, 0);
+    for (std::size_t i = 0; i < size; i++) {
+      const auto& port = multiport[i];
+      if (port.is_present()) {
+        values_[i] = *port.get();
+        present_[i / 64] |= std::uint64_t{1} << (i % 64);
+      }
+    }
+  }
+
+  [[nodiscard]] std::size_t size() const noexcept { return values_.size(); }
+  [[nodiscard]] bool is_present(std::size_t index) const noexcept {
+    return ((present_[index / 64] >> (index % 64)) & 1) != 0;
+  }
+
+  /** The number of channels that were present when the view was loaded. */
+  [[nodiscard]] std::size_t present_count() const noexcept {
+    std::size_t count{0};
+    for (auto word : present_) {
+      count += static_cast<std::size_t>(std::popcount(word));
+    }
+    return count;
+  }
+
+  /** The presence bitmask, 64 channels per word, least significant bit first. */
+  [[nodiscard]] const std::vector<std::uint64_t>& presence_mask() const noexcept { return present_; }
+
+  [[nodiscard]] const T* data() const noexcept { return values_.data(); }
+  const T& operator[](std::size_t index) const { return values_[index]; }
+  auto begin() const noexcept { return values_.begin(); }
+  auto end() const noexcept { return values_.end(); }
+};
+
+/**
+ * A real-time-safe asynchronous logger.
+ *
+ * reactor::log formats synchronously on the calling thread, so a log statement inside a
+ * deadline-bearing reaction pays for stream formatting and a lock on the critical path. Here the
+ * calling thread only copies a static format string pointer and up to four arguments into a
+ * per-thread lock-free ring; a background drain thread renders the records with std::to_chars and
+ * writes them to stderr. When a ring overflows, records are dropped and counted rather than
+ * blocking the producer.
+ *
+ * Format strings must have static storage duration and use "{}" placeholders:
+ *
+ *   lfutil::async_log::log("sensor {} exceeded threshold: {}", index, value);
+ *
+ * String arguments are captured as raw pointers and are read on the drain thread, so only string
+ * literals and other static strings are safe to pass. Per-thread rings are registered on first
+ * use and live until shutdown, which matches the fixed worker pool of the scheduler.
+ */
+namespace async_log {
+
+/** The maximum number of arguments that fit into one log record. */
+constexpr std::size_t max_args = 4;
+
+namespace detail {
+
+/** One argument captured by value, with a tag selecting how the drain thread renders it. */
+struct Arg {
+  enum class Type : std::uint8_t { none, boolean, signed_int, unsigned_int, floating, string };
+  Type type{Type::none};
+  union {
+    bool boolean_value;
+    std::int64_t signed_value;
+    std::uint64_t unsigned_value;
+    double floating_value;
+    const char* string_value;
+  };
+};
+
+template <class T> struct always_false : std::false_type {};
+
+template <class T> Arg make_arg(T value) {
+  Arg arg;
+  if constexpr (std::is_same_v<T, bool>) {
+    arg.type = Arg::Type::boolean;
+    arg.boolean_value = value;
+  } else if constexpr (std::is_floating_point_v<T>) {
+    arg.type = Arg::Type::floating;
+    arg.floating_value = static_cast<double>(value);
+  } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+    arg.type = Arg::Type::signed_int;
+    arg.signed_value = static_cast<std::int64_t>(value);
+  } else if constexpr (std::is_integral_v<T>) {
+    arg.type = Arg::Type::unsigned_int;
+    arg.unsigned_value = static_cast<std::uint64_t>(value);
+  } else if constexpr (std::is_convertible_v<T, const char*>) {
+    arg.type = Arg::Type::string;
+    arg.string_value = value;
   } else {
-    port->set(std::move(action->get()));
+    static_assert(always_false<T>::value,
+                  "async_log arguments must be arithmetic values or static strings");
+  }
+  return arg;
+}
+
+/** One pending log record: a static format string plus the captured arguments. */
+struct Record {
+  const char* format{nullptr};
+  std::array<Arg, max_args> args{};
+};
+
+} // namespace detail
+
+/** The singleton drain: owns the per-thread rings and the background formatting thread. */
+class Logger {
+private:
+  static constexpr std::size_t ring_capacity = 2048;
+  using Ring = SpscChannel<detail::Record, ring_capacity>;
+
+  std::mutex mutex_;
+  std::vector<std::unique_ptr<Ring>> rings_;
+  std::atomic<std::uint64_t> dropped_{0};
+  std::atomic<bool> stop_{false};
+  std::thread drain_;
+
+  Logger()
+      : drain_([this]() { run(); }) {}
+
+  ~Logger() {
+    stop_.store(true, std::memory_order_release);
+    drain_.join();
   }
+
+  static void append(std::string& out, const detail::Arg& arg) {
+    std::array<char, 32> buffer{};
+    switch (arg.type) {
+    case detail::Arg::Type::boolean:
+      out += arg.boolean_value ? "true" : "false";
+      break;
+    case detail::Arg::Type::signed_int: {
+      const auto [ptr, error] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), arg.signed_value);
+      out.append(buffer.data(), ptr);
+      break;
+    }
+    case detail::Arg::Type::unsigned_int: {
+      const auto [ptr, error] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), arg.unsigned_value);
+      out.append(buffer.data(), ptr);
+      break;
+    }
+    case detail::Arg::Type::floating: {
+      const auto [ptr, error] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), arg.floating_value);
+      out.append(buffer.data(), ptr);
+      break;
+    }
+    case detail::Arg::Type::string:
+      out += arg.string_value;
+      break;
+    case detail::Arg::Type::none:
+      out += "{}";
+      break;
+    }
+  }
+
+  static void render(std::string& out, const detail::Record& record) {
+    const std::string_view format{record.format};
+    std::size_t arg_index{0};
+    std::size_t pos{0};
+    while (true) {
+      const auto placeholder = format.find("{}", pos);
+      if (placeholder == std::string_view::npos) {
+        out.append(format.substr(pos));
+        break;
+      }
+      out.append(format.substr(pos, placeholder - pos));
+      if (arg_index < max_args && record.args[arg_index].type != detail::Arg::Type::none) {
+        append(out, record.args[arg_index]);
+        arg_index++;
+      } else {
+        out += "{}";
+      }
+      pos = placeholder + 2;
+    }
+    out += '\n';
+  }
+
+  void run() {
+    std::string line;
+    while (true) {
+      const bool stopping = stop_.load(std::memory_order_acquire);
+      std::size_t drained{0};
+      {
+        std::lock_guard<std::mutex> lock{mutex_};
+        for (auto& ring : rings_) {
+          drained += ring->pop_all([&line](detail::Record&& record) {
+            line.clear();
+            render(line, record);
+            std::fwrite(line.data(), 1, line.size(), stderr);
+          });
+        }
+      }
+      if (stopping && drained == 0) {
+        break;
+      }
+      if (drained == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+      }
+    }
+    const auto dropped = dropped_.load(std::memory_order_relaxed);
+    if (dropped > 0) {
+      std::fprintf(stderr, "[async_log] dropped %llu records due to ring overflow\n",
+                   static_cast<unsigned long long>(dropped));
+    }
+  }
+
+public:
+  Logger(const Logger&) = delete;
+  Logger& operator=(const Logger&) = delete;
+
+  static Logger& instance() {
+    static Logger logger;
+    return logger;
+  }
+
+  /** Queue a record on the calling thread's ring, registering the ring on first use. */
+  void push(detail::Record&& record) {
+    thread_local Ring* ring{nullptr};
+    if (ring == nullptr) {
+      auto owned = std::make_unique<Ring>();
+      ring = owned.get();
+      std::lock_guard<std::mutex> lock{mutex_};
+      rings_.push_back(std::move(owned));
+    }
+    if (!ring->try_push(std::move(record))) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+};
+
+/** Queue a log record; the calling thread neither formats nor allocates. */
+template <class... Args> void log(const char* format, Args... args) {
+  static_assert(sizeof...(Args) <= max_args, "async_log records hold at most four arguments");
+  detail::Record record{};
+  record.format = format;
+  [[maybe_unused]] std::size_t index{0};
+  ((record.args[index++] = detail::make_arg(args)), ...);
+  Logger::instance().push(std::move(record));
 }
 
+} // namespace async_log
+
+/**
+ * Apply the given body to every index in [0, count), distributing contiguous blocks of indices
+ * over a pool of freshly spawned threads.
+ *
+ * This is a startup-phase primitive, not a general task system: threads are created on every call
+ * and joined before it returns, which only amortizes for bodies that do substantial work per
+ * index, such as constructing reactor subtrees. The body is invoked as body(begin, end) with one
+ * contiguous index block per thread and must not touch shared mutable state; in particular,
+ * constructing reactors in parallel requires a runtime whose reactor and environment registration
+ * is thread-safe.
+ */
+template <class Body> void parallel_for(std::size_t count, unsigned max_threads, Body&& body) {
+  const auto hardware = std::thread::hardware_concurrency();
+  const auto threads = std::min<std::size_t>({count, max_threads, hardware > 0 ? hardware : 1});
+  if (threads <= 1) {
+    body(std::size_t{0}, count);
+    return;
+  }
+  const auto block = (count + threads - 1) / threads;
+  std::vector<std::thread> pool;
+  pool.reserve(threads);
+  for (std::size_t begin = 0; begin < count; begin += block) {
+    const auto end = std::min(begin + block, count);
+    pool.emplace_back([&body, begin, end]() { body(begin, end); });
+  }
+  for (auto& thread : pool) {
+    thread.join();
+  }
+}
+
+#if defined(__linux__)
+
+/** Read the list of CPUs belonging to the given NUMA node from sysfs. */
+inline std::vector<int> cpus_of_numa_node(int node) {
+  std::vector<int> cpus;
+  std::ifstream cpulist{"/sys/devices/system/node/node" + std::to_string(node) + "/cpulist"};
+  int first{0};
+  while (cpulist >> first) {
+    int last{first};
+    if (cpulist.peek() == '-') {
+      cpulist.ignore();
+      cpulist >> last;
+    }
+    for (int cpu = first; cpu <= last; cpu++) {
+      cpus.push_back(cpu);
+    }
+    if (cpulist.peek() == ',') {
+      cpulist.ignore();
+    }
+  }
+  return cpus;
+}
+
+/** Restrict the calling process to the given CPUs. */
+inline bool pin_to_cpus(const std::vector<int>& cpus) {
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (int cpu : cpus) {
+    CPU_SET(cpu, &set);
+  }
+  return sched_setaffinity(0, sizeof(set), &set) == 0;
+}
+
+/** Get all CPUs the calling process is currently allowed to run on. */
+inline std::vector<int> allowed_cpus() {
+  std::vector<int> cpus;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+      if (CPU_ISSET(cpu, &set)) {
+        cpus.push_back(cpu);
+      }
+    }
+  }
+  return cpus;
+}
+
+#endif
+
+/**
+ * Configure where the scheduler's worker threads may run.
+ *
+ * The resulting CPU mask is applied to the calling process before the environment spawns its
+ * workers, so all worker threads inherit it; no individual worker is ever bound to a particular
+ * CPU. With pin_workers, the mask is narrowed to as many CPUs as there are workers; numa_node (if
+ * non-negative) restricts the mask to the CPUs of that node; and worker_cpus ("CPU,CPU,...")
+ * restricts it to the explicitly listed CPUs.
+ */
+inline void apply_worker_affinity(unsigned workers, bool pin_workers, int numa_node,
+                                  const std::string& worker_cpus) {
+#if defined(__linux__)
+  if (!pin_workers && numa_node < 0 && worker_cpus.empty()) {
+    return;
+  }
+
+  std::vector<int> cpus = numa_node >= 0 ? cpus_of_numa_node(numa_node) : allowed_cpus();
+  if (numa_node >= 0 && cpus.empty()) {
+    reactor::log::Warn() << "NUMA node " << numa_node << " has no CPUs. Not applying any affinity!";
+    return;
+  }
+
+  if (!worker_cpus.empty()) {
+    // keep only the CPUs given in the comma-separated list
+    std::vector<int> listed;
+    std::size_t pos{0};
+    const char* const chars = worker_cpus.data();
+    while (pos < worker_cpus.size()) {
+      auto comma = worker_cpus.find(',', pos);
+      auto entry_end = comma == std::string::npos ? worker_cpus.size() : comma;
+      int cpu{0};
+      auto result = std::from_chars(chars + pos, chars + entry_end, cpu);
+      if (result.ec != std::errc{} || result.ptr != chars + entry_end || cpu < 0) {
+        reactor::log::Warn() << "Ignoring malformed worker CPU list: " << worker_cpus;
+        return;
+      }
+      listed.push_back(cpu);
+      pos = entry_end + 1;
+    }
+    cpus = std::move(listed);
+  } else if (pin_workers && cpus.size() > workers) {
+    cpus.resize(workers);
+  }
+
+  if (!pin_to_cpus(cpus)) {
+    reactor::log::Warn() << "Failed to apply the worker CPU affinity!";
+  }
+#else
+  (void)workers;
+  if (pin_workers || numa_node >= 0 || !worker_cpus.empty()) {
+    reactor::log::Warn() << "Worker affinity options are only supported on Linux!";
+  }
+#endif
+}
+
+/**
+ * Defer scheduling a physical action to burst boundaries under high event rates.
+ *
+ * An ActionBatcher accumulates values in a producer-local buffer and hands them to the runtime
+ * once a batch is full or the oldest pending value has waited longer than the flush interval.
+ * Reactions still observe one event per value, and each value still pays a full schedule() call
+ * at flush time, with its lock acquisition and scheduler wakeup; the runtime offers no bulk
+ * scheduling entry point that could amortize that cost. What batching buys is that the producer's
+ * hot path between flushes is a plain push_back, so synchronization is moved off the
+ * latency-critical stretch of the producer in exchange for up to max_delay of added latency per
+ * value. Do not use it expecting a throughput gain.
+ *
+ * A batcher belongs to the producing thread: construct one in the I/O thread that feeds the
+ * action and call schedule() on it instead of on the action. It is not thread safe; use one
+ * batcher per producer. Call flush() before the producer goes idle so no values are stranded
+ * waiting for the next schedule() call.
+ */
+template <class T> class ActionBatcher {
+private:
+  reactor::PhysicalAction<T>* action_;
+  std::size_t max_batch_;
+  std::chrono::microseconds max_delay_;
+  std::vector<T> pending_;
+  std::chrono::steady_clock::time_point oldest_pending_{};
+
+public:
+  ActionBatcher(reactor::PhysicalAction<T>* action, std::size_t max_batch = 64,
+                std::chrono::microseconds max_delay = std::chrono::microseconds{100})
+      : action_(action)
+      , max_batch_(max_batch)
+      , max_delay_(max_delay) {}
+
+  void schedule(T&& value) {
+    if (pending_.empty()) {
+      pending_.reserve(max_batch_);
+      oldest_pending_ = std::chrono::steady_clock::now();
+    }
+    pending_.push_back(std::move(value));
+    if (pending_.size() >= max_batch_ || std::chrono::steady_clock::now() - oldest_pending_ >= max_delay_) {
+      flush();
+    }
+  }
+
+  /** Hand all pending values to the runtime, one schedule() call per value. */
+  void flush() {
+    for (auto& value : pending_) {
+      action_->schedule(std::move(value));
+    }
+    pending_.clear();
+  }
+
+  [[nodiscard]] auto pending() const noexcept -> std::size_t { return pending_.size(); }
+};
+
 class LFScope {
 private:
   reactor::Reactor* reactor;
@@ -65,39 +901,667 @@ public:
   void request_stop() const { return environment()->sync_shutdown(); }
 };
 
+/**
+ * Draw connections between all left and right ports in one bulk operation.
+ *
+ * The connection properties are applied directly to every pair, which avoids the indirect call
+ * through a type-erased connect callback for each individual connection. An iterated connection
+ * (repeat_left) cycles through the left ports by index, so a single source fanning out to an
+ * arbitrarily wide bank needs no extra memory beyond the two port vectors themselves.
+ */
 template <class PortPtr>
-void bind_multiple_ports(std::vector<PortPtr>& left_ports, std::vector<PortPtr>& right_ports, bool repeat_left,
-                         std::function<void(PortPtr, PortPtr)> connect) {
+void draw_connections(std::vector<PortPtr>& left_ports, std::vector<PortPtr>& right_ports, bool repeat_left,
+                      const reactor::ConnectionProperties& properties) {
+  const auto l_size = left_ports.size();
+  const auto r_size = right_ports.size();
+
   if (repeat_left) {
-    auto l_size = left_ports.size();
-    auto r_size = right_ports.size();
-    // divide and round up
-    auto repetitions = r_size / l_size + (r_size % l_size != 0);
-    // repeat repetitions-1 times
-    left_ports.reserve(repetitions * l_size);
-    for (std::size_t i{1}; i < repetitions; i++) {
-      std::copy_n(left_ports.begin(), l_size, std::back_inserter(left_ports));
+    if (r_size % l_size != 0) {
+      reactor::log::Warn() << "The left ports do not evenly divide the right ports. "
+                           << "Not all ports will be connected!";
+    }
+    for (std::size_t i{0}; i < r_size; i++) {
+      auto& left = left_ports[i % l_size];
+      left->environment()->draw_connection(left, right_ports[i], properties);
     }
+    return;
   }
 
-  auto left_it = left_ports.begin();
-  auto right_it = right_ports.begin();
-
-  if (left_ports.size() < right_ports.size()) {
+  if (l_size < r_size) {
     reactor::log::Warn() << "There are more right ports than left ports. "
                          << "Not all ports will be connected!";
-  } else if (left_ports.size() > right_ports.size()) {
+  } else if (l_size > r_size) {
     reactor::log::Warn() << "There are more left ports than right ports. "
                          << "Not all ports will be connected!";
   }
 
-  while (left_it != left_ports.end() && right_it != right_ports.end()) {
-    auto left = *left_it;
-    auto right = *right_it;
-    connect(left, right);
-    left_it++;
-    right_it++;
+  const auto count = std::min(l_size, r_size);
+  for (std::size_t i{0}; i < count; i++) {
+    left_ports[i]->environment()->draw_connection(left_ports[i], right_ports[i], properties);
   }
 }
 
+namespace checkpoint {
+
+namespace detail {
+template <class T> struct is_vector : std::false_type {};
+template <class T, class A> struct is_vector<std::vector<T, A>> : std::true_type {};
+template <class T> struct always_false : std::false_type {};
+} // namespace detail
+
+/**
+ * Serializes reactor state into a snapshot file.
+ *
+ * The generated __lf_checkpoint_save methods write all state variables of a reactor tree in
+ * declaration order, so a snapshot can only be restored by the same binary that produced it.
+ * Supported state types are trivially copyable values, std::string, and std::vector of supported
+ * types; anything else fails to compile with a pointed error message.
+ */
+class Writer {
+private:
+  std::ofstream out_;
+
+public:
+  explicit Writer(const std::string& path)
+      : out_(path, std::ios::binary | std::ios::trunc) {
+    const std::uint32_t version{1};
+    out_.write("LFCP", 4);
+    out_.write(reinterpret_cast<const char*>(&version), sizeof(version));
+  }
+
+  [[nodiscard]] bool ok() const { return out_.good(); }
+
+  template <class T> void save(const T& value) {
+    if constexpr (detail::is_vector<T>::value) {
+      const std::uint64_t size = value.size();
+      save(size);
+      if constexpr (std::is_same_v<typename T::value_type, bool>) {
+        // std::vector<bool> iterates as proxy objects; copy each bit into a real bool so the
+        // trivially-copyable branch below writes the value rather than the proxy's internals
+        for (const bool element : value) {
+          save(element);
+        }
+      } else {
+        for (const auto& element : value) {
+          save(element);
+        }
+      }
+    } else if constexpr (std::is_same_v<T, std::string>) {
+      const std::uint64_t size = value.size();
+      save(size);
+      out_.write(value.data(), static_cast<std::streamsize>(size));
+    } else if constexpr (std::is_trivially_copyable_v<T>) {
+      out_.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    } else {
+      static_assert(detail::always_false<T>::value,
+                    "state variables must be trivially copyable, std::string, or std::vector of "
+                    "such types to be checkpointed");
+    }
+  }
+};
+
+/**
+ * Restores reactor state from a snapshot file written by Writer.
+ *
+ * On Linux the snapshot is memory mapped, so restoring costs page faults on the bytes actually
+ * read rather than an upfront copy of the whole file; other platforms fall back to reading the
+ * file into memory. All reads are bounds checked and any mismatch marks the reader as failed, so
+ * callers must check ok() after restoring.
+ */
+class Reader {
+private:
+  const char* data_{nullptr};
+  std::size_t size_{0};
+  std::size_t offset_{0};
+  bool ok_{false};
+#if defined(__linux__)
+  void* mapping_{nullptr};
+  std::size_t mapping_size_{0};
+#else
+  std::string buffer_;
+#endif
+
+public:
+  explicit Reader(const std::string& path) {
+#if defined(__linux__)
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      return;
+    }
+    struct stat info {};
+    if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+      mapping_size_ = static_cast<std::size_t>(info.st_size);
+      void* mapping = ::mmap(nullptr, mapping_size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (mapping != MAP_FAILED) {
+        mapping_ = mapping;
+        data_ = static_cast<const char*>(mapping);
+        size_ = mapping_size_;
+      }
+    }
+    ::close(fd);
+#else
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (in) {
+      buffer_.resize(static_cast<std::size_t>(in.tellg()));
+      in.seekg(0);
+      in.read(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+      data_ = buffer_.data();
+      size_ = buffer_.size();
+    }
+#endif
+    if (data_ != nullptr && size_ >= 8 && std::memcmp(data_, "LFCP", 4) == 0) {
+      std::uint32_t version{0};
+      std::memcpy(&version, data_ + 4, sizeof(version));
+      ok_ = version == 1;
+      offset_ = 8;
+    }
+  }
+
+  ~Reader() {
+#if defined(__linux__)
+    if (mapping_ != nullptr) {
+      ::munmap(mapping_, mapping_size_);
+    }
+#endif
+  }
+
+  Reader(const Reader&) = delete;
+  Reader& operator=(const Reader&) = delete;
+
+  [[nodiscard]] bool ok() const { return ok_; }
+
+  template <class T> void restore(T& value) {
+    if constexpr (detail::is_vector<T>::value) {
+      std::uint64_t size{0};
+      restore(size);
+      // A corrupt size field must not reach resize(). Every element occupies at least
+      // min_element_size bytes of snapshot, so any larger count cannot come from a valid file.
+      using Element = typename T::value_type;
+      constexpr std::uint64_t min_element_size =
+          std::is_trivially_copyable_v<Element> ? sizeof(Element) : sizeof(std::uint64_t);
+      if (!ok_ || size > remaining() / min_element_size) {
+        ok_ = false;
+        return;
+      }
+      value.clear();
+      value.resize(static_cast<std::size_t>(size));
+      if constexpr (std::is_same_v<Element, bool>) {
+        // std::vector<bool> hands out proxy references that a plain reference cannot bind to
+        for (std::size_t index = 0; index < value.size(); index++) {
+          bool element{false};
+          restore(element);
+          value[index] = element;
+        }
+      } else {
+        for (auto& element : value) {
+          restore(element);
+        }
+      }
+    } else if constexpr (std::is_same_v<T, std::string>) {
+      std::uint64_t size{0};
+      restore(size);
+      if (!ok_ || size > remaining()) {
+        ok_ = false;
+        return;
+      }
+      value.assign(data_ + offset_, static_cast<std::size_t>(size));
+      offset_ += static_cast<std::size_t>(size);
+    } else if constexpr (std::is_trivially_copyable_v<T>) {
+      take(&value, sizeof(T));
+    } else {
+      static_assert(detail::always_false<T>::value,
+                    "state variables must be trivially copyable, std::string, or std::vector of "
+                    "such types to be checkpointed");
+    }
+  }
+
+private:
+  /** The number of snapshot bytes that have not been consumed yet. */
+  [[nodiscard]] std::size_t remaining() const { return size_ - offset_; }
+
+  void take(void* destination, std::size_t count) {
+    if (!ok_ || count > remaining()) {
+      ok_ = false;
+      return;
+    }
+    std::memcpy(destination, data_ + offset_, count);
+    offset_ += count;
+  }
+};
+
+} // namespace checkpoint
+
+/**
+ * Per-reactor heap accounting.
+ *
+ * With the memory-accounting target property, the generated main replaces the global allocation
+ * functions with allocate()/deallocate() below, and reactor construction runs inside an
+ * AccountingScope naming the instance being built. Every allocation carries a small header
+ * pointing at the bucket of the scope that made it, so frees decrement the right bucket no matter
+ * which thread performs them. dump() prints live bytes (self and subtree) and cumulative
+ * allocation counts per reactor FQN.
+ *
+ * Only construction-time allocations are attributed automatically; allocations made by reactions
+ * at runtime land in the unattributed bucket unless the reaction body opens a scope of its own.
+ * Over-aligned allocations (such as the bank arenas of BankStorage) bypass the replaced operators
+ * and are not accounted.
+ */
+namespace memory {
+
+/** A live accounting bucket for one reactor instance. */
+struct Stats {
+  std::string fqn;
+  std::atomic<std::uint64_t> live_bytes{0};
+  std::atomic<std::uint64_t> allocation_count{0};
+
+  explicit Stats(std::string fqn)
+      : fqn(std::move(fqn)) {}
+};
+
+/** The bucket that receives allocations made by the calling thread. */
+inline thread_local Stats* current_scope{nullptr};
+
+/** The singleton owning all per-reactor buckets. */
+class Registry {
+private:
+  std::mutex mutex_;
+  std::vector<std::unique_ptr<Stats>> stats_;
+  std::atomic<std::uint64_t> unattributed_bytes_{0};
+  std::atomic<std::uint64_t> unattributed_count_{0};
+
+  // the constructor must not allocate: it may run lazily from inside the allocator itself
+  Registry() = default;
+
+public:
+  Registry(const Registry&) = delete;
+  Registry& operator=(const Registry&) = delete;
+
+  static Registry& instance() {
+    static Registry registry;
+    return registry;
+  }
+
+  /** The bucket registered under the given FQN, created on first use. */
+  Stats& stats(const std::string& fqn) {
+    std::lock_guard<std::mutex> lock{mutex_};
+    for (const auto& stats : stats_) {
+      if (stats->fqn == fqn) {
+        return *stats;
+      }
+    }
+    stats_.push_back(std::make_unique<Stats>(fqn));
+    return *stats_.back();
+  }
+
+  void count_unattributed(std::uint64_t bytes) {
+    unattributed_bytes_.fetch_add(bytes, std::memory_order_relaxed);
+    unattributed_count_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void release_unattributed(std::uint64_t bytes) {
+    unattributed_bytes_.fetch_sub(bytes, std::memory_order_relaxed);
+  }
+
+  /** Print live bytes (self and subtree) and allocation counts per reactor FQN. */
+  void dump(std::ostream& out) {
+    std::lock_guard<std::mutex> lock{mutex_};
+    std::vector<const Stats*> sorted;
+    sorted.reserve(stats_.size());
+    for (const auto& stats : stats_) {
+      sorted.push_back(stats.get());
+    }
+    std::sort(sorted.begin(), sorted.end(),
+              [](const Stats* a, const Stats* b) { return a->fqn < b->fqn; });
+
+    out << "memory statistics: live bytes (self / subtree), allocations\n";
+    for (const auto* stats : sorted) {
+      // aggregate the subtree by summing all buckets below this FQN in the containment hierarchy
+      const std::string prefix = stats->fqn + ".";
+      auto subtree = stats->live_bytes.load(std::memory_order_relaxed);
+      for (const auto* other : sorted) {
+        if (other->fqn.compare(0, prefix.size(), prefix) == 0) {
+          subtree += other->live_bytes.load(std::memory_order_relaxed);
+        }
+      }
+      out << "  " << stats->fqn << ": " << stats->live_bytes.load(std::memory_order_relaxed) << " / "
+          << subtree << " bytes, " << stats->allocation_count.load(std::memory_order_relaxed)
+          << " allocations\n";
+    }
+    out << "  (unattributed): " << unattributed_bytes_.load(std::memory_order_relaxed) << " bytes, "
+        << unattributed_count_.load(std::memory_order_relaxed) << " allocations\n";
+  }
+};
+
+/** Attribute all allocations made by the calling thread to the given bucket while alive. */
+class AccountingScope {
+private:
+  Stats* previous_;
+
+public:
+  explicit AccountingScope(Stats& stats)
+      : previous_(current_scope) {
+    current_scope = &stats;
+  }
+
+  AccountingScope(const AccountingScope&) = delete;
+  AccountingScope& operator=(const AccountingScope&) = delete;
+
+  ~AccountingScope() { current_scope = previous_; }
+};
+
+namespace detail {
+
+/** The bookkeeping prefix of every accounted allocation, padded to the strictest alignment. */
+struct alignas(alignof(std::max_align_t)) Header {
+  Stats* stats;
+  std::size_t size;
+};
+
+} // namespace detail
+
+/** The replacement for operator new: malloc plus a header naming the owning bucket. */
+inline void* allocate(std::size_t size) {
+  void* raw = std::malloc(size + sizeof(detail::Header));
+  if (raw == nullptr) {
+    throw std::bad_alloc{};
+  }
+  auto* header = static_cast<detail::Header*>(raw);
+  header->stats = current_scope;
+  header->size = size;
+  if (current_scope != nullptr) {
+    current_scope->live_bytes.fetch_add(size, std::memory_order_relaxed);
+    current_scope->allocation_count.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    Registry::instance().count_unattributed(size);
+  }
+  return header + 1;
+}
+
+/** The replacement for operator delete: return the bytes to the bucket that allocated them. */
+inline void deallocate(void* ptr) noexcept {
+  if (ptr == nullptr) {
+    return;
+  }
+  auto* header = static_cast<detail::Header*>(ptr) - 1;
+  if (header->stats != nullptr) {
+    header->stats->live_bytes.fetch_sub(header->size, std::memory_order_relaxed);
+  } else {
+    Registry::instance().release_unattributed(header->size);
+  }
+  std::free(header);
+}
+
+/** Evaluate the given factory while attributing its allocations to the given reactor FQN. */
+template <class Make> auto scoped_construct(const std::string& fqn, Make&& make) {
+  AccountingScope scope{Registry::instance().stats(fqn)};
+  return make();
+}
+
+} // namespace memory
+
+#ifdef LF_REACTION_TRACING
+
+namespace trace {
+
+/** A fixed-size record describing one reaction or deadline handler enter/exit event. */
+struct Record {
+  const char* reactor;
+  const char* reaction;
+  std::uint64_t timestamp_ns;
+  bool enter;
+};
+
+/**
+ * Collects trace records from all worker threads and exports them as Chrome trace-event JSON.
+ *
+ * Each thread writes into its own lock-free ring buffer, so recording on the hot path is a
+ * timestamp read plus a ring-buffer push. A background drain thread periodically empties all
+ * buffers into the trace file (LF_TRACE_FILE, defaulting to trace.json), which Perfetto and
+ * chrome://tracing load directly. Records are dropped, not blocked on, when a buffer overflows.
+ */
+class Tracer {
+private:
+  std::mutex registry_mutex_;
+  std::vector<std::pair<std::size_t, std::unique_ptr<SpscChannel<Record, 8192>>>> buffers_;
+  std::ofstream out_;
+  std::atomic<bool> stop_{false};
+  std::thread drain_thread_;
+
+  Tracer() {
+    const char* path = std::getenv("LF_TRACE_FILE");
+    out_.open(path != nullptr ? path : "trace.json");
+    out_ << "[\n";
+    drain_thread_ = std::thread([this]() {
+      while (!stop_.load(std::memory_order_acquire)) {
+        drain();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      }
+      drain();
+    });
+  }
+
+  void drain() {
+    std::lock_guard<std::mutex> lock{registry_mutex_};
+    for (auto& [tid, buffer] : buffers_) {
+      buffer->pop_all([this, tid = tid](Record&& record) {
+        out_ << "{\"ph\":\"" << (record.enter ? 'B' : 'E') << "\",\"pid\":0,\"tid\":" << tid
+             << ",\"ts\":" << static_cast<double>(record.timestamp_ns) / 1e3 << ",\"name\":\"" << record.reactor
+             << '.' << record.reaction << "\"},\n";
+      });
+    }
+  }
+
+public:
+  ~Tracer() {
+    stop_.store(true, std::memory_order_release);
+    drain_thread_.join();
+    out_ << "]\n";
+  }
+
+  static Tracer& get() {
+    static Tracer singleton;
+    return singleton;
+  }
+
+  SpscChannel<Record, 8192>& local_buffer() {
+    thread_local SpscChannel<Record, 8192>* buffer = [this]() {
+      auto owned = std::make_unique<SpscChannel<Record, 8192>>();
+      auto* raw = owned.get();
+      std::lock_guard<std::mutex> lock{registry_mutex_};
+      buffers_.emplace_back(buffers_.size(), std::move(owned));
+      return raw;
+    }();
+    return *buffer;
+  }
+};
+
+/** Record an enter or exit event for the calling thread. */
+inline void record(const char* reactor, const char* reaction, bool enter) {
+  const auto now = std::chrono::steady_clock::now().time_since_epoch();
+  Record entry{reactor, reaction, static_cast<std::uint64_t>(
+                                      std::chrono::duration_cast<std::chrono::nanoseconds>(now).count()),
+               enter};
+  Tracer::get().local_buffer().try_push(std::move(entry));
+}
+
+/** Records the enter event on construction and the matching exit event on scope exit. */
+class ScopedTrace {
+private:
+  const char* reactor_;
+  const char* reaction_;
+
+public:
+  ScopedTrace(const char* reactor, const char* reaction)
+      : reactor_(reactor)
+      , reaction_(reaction) {
+    record(reactor_, reaction_, true);
+  }
+  ~ScopedTrace() { record(reactor_, reaction_, false); }
+};
+
+} // namespace trace
+
+#endif // LF_REACTION_TRACING
+
+#ifdef LF_RUNTIME_TELEMETRY
+
+namespace telemetry {
+
+/** A monotonically increasing event counter. Incrementing is a single relaxed atomic add. */
+class Counter {
+private:
+  std::atomic<std::uint64_t> value_{0};
+
+public:
+  void increment() noexcept { value_.fetch_add(1, std::memory_order_relaxed); }
+
+  [[nodiscard]] auto value() const noexcept -> std::uint64_t { return value_.load(std::memory_order_relaxed); }
+};
+
+/**
+ * The process-wide registry of telemetry counters.
+ *
+ * Counters are registered once per call site (guarded by a function-local static in the
+ * LF_TELEMETRY_COUNT macro), so the registry lock is only taken on the first invocation of each
+ * instrumented code path, never on the steady-state hot path. Counters are stored behind stable
+ * pointers so snapshots may run concurrently with registration.
+ */
+class Registry {
+private:
+  std::mutex mutex_;
+  std::vector<std::pair<std::string, std::unique_ptr<Counter>>> counters_;
+
+  Registry() = default;
+
+public:
+  static auto instance() -> Registry& {
+    // intentionally leaked: the metrics server thread is detached and may serve a snapshot while
+    // static destructors run at exit, so the registry must never be destroyed
+    static auto* registry = new Registry();
+    return *registry;
+  }
+
+  auto counter(const std::string& name) -> Counter& {
+    std::lock_guard<std::mutex> lock{mutex_};
+    for (auto& [existing_name, existing_counter] : counters_) {
+      if (existing_name == name) {
+        return *existing_counter;
+      }
+    }
+    counters_.emplace_back(name, std::make_unique<Counter>());
+    return *counters_.back().second;
+  }
+
+  /** Invoke sink(name, value) for every registered counter. */
+  template <class Sink> void snapshot(Sink&& sink) {
+    std::lock_guard<std::mutex> lock{mutex_};
+    for (const auto& [name, counter] : counters_) {
+      sink(name, counter->value());
+    }
+  }
+};
+
+#if defined(__linux__)
+
+/**
+ * Serve telemetry snapshots on a loopback TCP port from a detached background thread.
+ *
+ * The protocol is a minimal binary framing in host byte order: the magic bytes "LFTM", a
+ * uint32 protocol version (1) and a uint32 counter count, followed by one record per counter
+ * consisting of a uint16 name length, the name bytes, and the uint64 counter value. Each
+ * connection receives one snapshot and is closed, so polling clients need no framing logic
+ * beyond reading until EOF.
+ *
+ * The server thread is detached and runs until the process exits; the registry it reads is
+ * intentionally immortal, so a client connecting during process teardown still gets a valid
+ * (possibly final) snapshot instead of a use-after-destroy.
+ */
+inline void start_metrics_server(unsigned short port) {
+  std::thread([port]() {
+    int server_fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (server_fd < 0) {
+      reactor::log::Warn() << "could not create the metrics server socket";
+      return;
+    }
+    int reuse{1};
+    ::setsockopt(server_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+    if (::bind(server_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+        ::listen(server_fd, 4) < 0) {
+      reactor::log::Warn() << "could not bind the metrics server to port " << port;
+      ::close(server_fd);
+      return;
+    }
+    while (true) {
+      int client_fd = ::accept(server_fd, nullptr, nullptr);
+      if (client_fd < 0) {
+        continue;
+      }
+      std::string buffer{"LFTM"};
+      const auto append = [&buffer](const auto& value) {
+        buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+      };
+      const std::uint32_t version{1};
+      append(version);
+      std::uint32_t count{0};
+      const auto count_offset = buffer.size();
+      append(count);
+      Registry::instance().snapshot([&](const std::string& name, std::uint64_t value) {
+        const auto length = static_cast<std::uint16_t>(name.size());
+        append(length);
+        buffer.append(name);
+        append(value);
+        count++;
+      });
+      std::memcpy(buffer.data() + count_offset, &count, sizeof(count));
+      std::size_t written{0};
+      while (written < buffer.size()) {
+        const auto result = ::write(client_fd, buffer.data() + written, buffer.size() - written);
+        if (result <= 0) {
+          break;
+        }
+        written += static_cast<std::size_t>(result);
+      }
+      ::close(client_fd);
+    }
+  }).detach();
+}
+
+#else
+
+inline void start_metrics_server(unsigned short) {
+  reactor::log::Warn() << "the metrics server is only supported on Linux";
+}
+
+#endif // defined(__linux__)
+
+} // namespace telemetry
+
+#endif // LF_RUNTIME_TELEMETRY
+
 } // namespace lfutil
+
+// The hot-path tracing hook emitted at the top of every generated reaction body and deadline
+// handler. Without the reaction-tracing target property this expands to nothing.
+#ifdef LF_REACTION_TRACING
+#define LF_TRACE_REACTION_SCOPE(reactor, reaction)                                                                     \
+  const ::lfutil::trace::ScopedTrace __lf_trace_scope { reactor, reaction }
+#else
+#define LF_TRACE_REACTION_SCOPE(reactor, reaction) (void)0
+#endif
+
+// The hot-path telemetry hook emitted in generated reaction bodies and deadline handlers. The
+// counter lookup runs once per call site; afterwards each invocation is one relaxed atomic
+// increment. Without the runtime-telemetry target property this expands to nothing.
+#ifdef LF_RUNTIME_TELEMETRY
+#define LF_TELEMETRY_COUNT(name)                                                                                       \
+  do {                                                                                                                 \
+    static auto& __lf_telemetry_counter = ::lfutil::telemetry::Registry::instance().counter(name);                     \
+    __lf_telemetry_counter.increment();                                                                                \
+  } while (false)
+#else
+#define LF_TELEMETRY_COUNT(name) (void)0
+#endif
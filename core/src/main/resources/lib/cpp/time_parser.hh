@@ -31,13 +31,18 @@ std::stringstream& operator>>(std::stringstream& in, reactor::Duration& dur);
 #include "CLI/cxxopts.hpp"
 
 #include <algorithm>
-#include <fstream>
-#include <iostream>
-#include <regex>
+#include <array>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
 #include <string>
+#include <string_view>
+#include <type_traits>
 
-bool iequals(const std::string& a, const std::string& b) {
-  return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](char a, char b) { return tolower(a) == tolower(b); });
+inline bool iequals(std::string_view a, std::string_view b) {
+  return a.size() == b.size() &&
+         std::equal(a.begin(), a.end(), b.begin(), [](char a, char b) { return tolower(a) == tolower(b); });
 }
 
 class argument_incorrect_type_with_reason : public cxxopts::OptionParseException {
@@ -47,118 +52,178 @@ public:
                                       reason + ")") {}
 };
 
-std::string validate_time_string(const std::string& time);
-
 /**
  * converts a reactor::Duration to a string with ns as unit
  */
-std::string time_to_string(const reactor::Duration& dur) {
+inline std::string time_to_string(const reactor::Duration& dur) {
   if (dur == reactor::Duration::max()) {
     return "forever";
   }
 
-  std::stringstream ss;
-  ss << dur.count() << " ns";
-  return ss.str();
+  // enough for a sign, 19 digits, and the " ns" suffix
+  std::array<char, 24> buffer{};
+  const auto [ptr, error] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), dur.count());
+  std::string result{buffer.data(), ptr};
+  result += " ns";
+  return result;
 }
 
 template <typename T> std::string any_to_string(const T val) {
-  std::stringstream ss;
-  ss << val;
-  return ss.str();
+  if constexpr (std::is_same_v<T, bool>) {
+    return val ? "true" : "false";
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+  } else if constexpr (std::is_arithmetic_v<T>) {
+#else
+  // floating-point std::to_chars is unimplemented on older standard libraries,
+  // so only integers take the allocation-free path there
+  } else if constexpr (std::is_integral_v<T>) {
+#endif
+    std::array<char, 32> buffer{};
+    const auto [ptr, error] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), val);
+    return std::string{buffer.data(), ptr};
+  } else {
+    // fall back to stream formatting for user-defined types that provide an operator<<
+    std::stringstream ss;
+    ss << val;
+    return ss.str();
+  }
 }
 
-std::stringstream& operator>>(std::stringstream& in, reactor::Duration& dur) {
-  double value;
-  std::string unit;
+/** An entry of the unit lookup table, mapping a unit name to its length in nanoseconds. */
+struct time_unit_entry {
+  std::string_view name;
+  double nanoseconds;
+};
 
-  const std::string validation_msg = validate_time_string(in.str());
-  if (!validation_msg.empty()) {
-    // throw cxxopts error
-    throw argument_incorrect_type_with_reason(in.str(), validation_msg);
+/** All time units accepted in LF time strings. */
+constexpr std::array<time_unit_entry, 28> time_units{{
+    {"nsec", 1.0},
+    {"nsecs", 1.0},
+    {"ns", 1.0},
+    {"usec", 1e3},
+    {"usecs", 1e3},
+    {"us", 1e3},
+    {"msec", 1e6},
+    {"msecs", 1e6},
+    {"ms", 1e6},
+    {"sec", 1e9},
+    {"secs", 1e9},
+    {"second", 1e9},
+    {"seconds", 1e9},
+    {"s", 1e9},
+    {"min", 60e9},
+    {"mins", 60e9},
+    {"minute", 60e9},
+    {"minutes", 60e9},
+    {"m", 60e9},
+    {"hour", 3600e9},
+    {"hours", 3600e9},
+    {"h", 3600e9},
+    {"day", 24 * 3600e9},
+    {"days", 24 * 3600e9},
+    {"d", 24 * 3600e9},
+    {"week", 7 * 24 * 3600e9},
+    {"weeks", 7 * 24 * 3600e9},
+    {"w", 7 * 24 * 3600e9},
+}};
+
+/**
+ * Parse a decimal value from the given character range.
+ *
+ * Floating-point std::from_chars is unimplemented on libc++ before LLVM 20 and libstdc++ before
+ * GCC 11, so those standard libraries fall back to strtod on a bounded local copy.
+ */
+inline bool parse_decimal(const char* first, const char* last, double& value) {
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+  const auto [ptr, error] = std::from_chars(first, last, value);
+  return error == std::errc{} && ptr == last;
+#else
+  std::array<char, 64> buffer{};
+  const auto size = static_cast<std::size_t>(last - first);
+  if (size == 0 || size >= buffer.size()) {
+    return false;
   }
+  std::memcpy(buffer.data(), first, size);
+  char* end = nullptr;
+  value = std::strtod(buffer.data(), &end);
+  return end == buffer.data() + size;
+#endif
+}
 
-  if (iequals(in.str(), "forever")) {
-    in >> unit; // parse the entire string
-    dur = reactor::Duration::max();
-    return in;
+/**
+ * Parse an LF time string in a single pass.
+ *
+ * This performs no heap allocations on the success path. On error, a message describing the
+ * problem is returned; on success, the result is written to dur and the empty string is returned.
+ */
+inline std::string parse_duration(std::string_view text, reactor::Duration& dur) {
+  constexpr std::string_view whitespace{" \t\n\r"};
+
+  const auto begin = text.find_first_not_of(whitespace);
+  if (begin == std::string_view::npos) {
+    return "The empty string is not a valid time!";
   }
+  text = text.substr(begin, text.find_last_not_of(whitespace) - begin + 1);
 
-  // try to read as double
-  in >> value;
+  if (text.front() == '-') {
+    return "Negative values are not a valid time!";
+  }
 
-  if (value == 0.0) {
-    dur = reactor::Duration::zero();
-    if (!in.eof()) {
-      // parse whatever remains
-      in >> unit;
+  if (iequals(text, "forever")) {
+    dur = reactor::Duration::max();
+    return "";
+  }
+
+  if (text.find_first_not_of("0.") == std::string_view::npos) {
+    // plain zero needs no unit, but a bare "." or a multi-dot string is not a number
+    if (text.find('0') == std::string_view::npos || text.find('.') != text.rfind('.')) {
+      return "Not a valid value: " + std::string{text};
     }
-  } else {
-    in >> unit;
-    if (unit == "nsec" || unit == "nsecs" || unit == "ns") {
-      std::chrono::duration<double, std::nano> tmp{value};
-      dur = std::chrono::duration_cast<reactor::Duration>(tmp);
-    } else if (unit == "usec" || unit == "usecs" || unit == "us") {
-      std::chrono::duration<double, std::micro> tmp{value};
-      dur = std::chrono::duration_cast<reactor::Duration>(tmp);
-    } else if (unit == "msec" || unit == "msecs" || unit == "ms") {
-      std::chrono::duration<double, std::milli> tmp{value};
-      dur = std::chrono::duration_cast<reactor::Duration>(tmp);
-    } else if (unit == "sec" || unit == "secs" || unit == "second" || unit == "seconds" || unit == "s") {
-      std::chrono::duration<double, std::ratio<1, 1>> tmp{value};
-      dur = std::chrono::duration_cast<reactor::Duration>(tmp);
-    } else if (unit == "min" || unit == "mins" || unit == "minute" || unit == "minutes" || unit == "m") {
-      std::chrono::duration<double, std::ratio<60, 1>> tmp{value};
-      dur = std::chrono::duration_cast<reactor::Duration>(tmp);
-    } else if (unit == "hour" || unit == "hours" || unit == "h") {
-      std::chrono::duration<double, std::ratio<3600, 1>> tmp{value};
-      dur = std::chrono::duration_cast<reactor::Duration>(tmp);
-    } else if (unit == "day" || unit == "days" || unit == "d") {
-      std::chrono::duration<double, std::ratio<24 * 3600, 1>> tmp{value};
-      dur = std::chrono::duration_cast<reactor::Duration>(tmp);
-    } else if (unit == "week" || unit == "weeks" || unit == "w") {
-      std::chrono::duration<double, std::ratio<7 * 24 * 3600, 1>> tmp{value};
+    dur = reactor::Duration::zero();
+    return "";
+  }
+
+  // the unit must directly follow the number, separated by whitespace at most; skipping ahead to
+  // the first letter would silently drop anything in between ("1 2 s" must not parse as one
+  // second), so everything after the number becomes the unit and has to match as a whole
+  const auto value_end = text.find_first_not_of("0123456789.");
+  const auto unit_begin = text.find_first_not_of(whitespace, value_end);
+  if (unit_begin == std::string_view::npos) {
+    return "No unit given!";
+  }
+  const auto unit = text.substr(unit_begin);
+
+  double value{0.0};
+  if (!parse_decimal(text.data(), text.data() + value_end, value)) {
+    return "Not a valid value: " + std::string{text.substr(0, value_end)};
+  }
+
+  for (const auto& entry : time_units) {
+    if (entry.name == unit) {
+      std::chrono::duration<double, std::nano> tmp{value * entry.nanoseconds};
       dur = std::chrono::duration_cast<reactor::Duration>(tmp);
-    } else {
-      // mark as error
-      in.setstate(std::ifstream::failbit);
+      return "";
     }
   }
-
-  return in;
+  return "Not a valid unit: " + std::string{unit};
 }
 
 /**
  *   Tests for correct syntax in unit usage for time strings
  **/
-std::string validate_time_string(const std::string& time) {
-  auto trimmed = std::regex_replace(time, std::regex("^ +| +$|( ) +"), "$1");
-  if (trimmed.size() == 0) {
-    return "The empty string is not a valid time!";
-  } else if (trimmed[0] == '-') {
-    return "Negative values are not a valid time!";
-  } else if (iequals("forever", time)) {
-    return ""; // "forever" is a valid value
-  } else if (trimmed.find_first_not_of("0.") == std::string::npos) {
-    return "";
-  } else {
-    auto pos = trimmed.find_first_not_of("0123456789. \n\r\t");
-    if (pos == std::string::npos) {
-      return "No unit given!";
-    } else {
-      auto unit = trimmed.substr(pos);
-      if (unit == "nsec" || unit == "nsecs" || unit == "ns" || unit == "usec" || unit == "usecs" || unit == "us" ||
-          unit == "msec" || unit == "msecs" || unit == "ms" || unit == "sec" || unit == "secs" || unit == "second" ||
-          unit == "seconds" || unit == "s" || unit == "min" || unit == "mins" || unit == "minute" ||
-          unit == "minutes" || unit == "m" || unit == "hour" || unit == "hours" || unit == "h" || unit == "day" ||
-          unit == "days" || unit == "d" || unit == "week" || unit == "weeks" || unit == "w") {
-        return "";
-      } else {
-        std::stringstream ss;
-        ss << "Not a valid unit: " << unit;
-        return ss.str();
-      }
-    }
+inline std::string validate_time_string(const std::string& time) {
+  reactor::Duration unused{};
+  return parse_duration(time, unused);
+}
+
+inline std::stringstream& operator>>(std::stringstream& in, reactor::Duration& dur) {
+  const std::string validation_msg = parse_duration(in.str(), dur);
+  if (!validation_msg.empty()) {
+    // throw cxxopts error
+    throw argument_incorrect_type_with_reason(in.str(), validation_msg);
   }
-  return "Unexpected error!";
+
+  // mark the entire stream as consumed
+  in.ignore(std::numeric_limits<std::streamsize>::max());
+  return in;
 }
@@ -128,6 +128,7 @@ public abstract class TestBase extends LfInjectedTestBase {
     public static final String NO_ENCLAVE_SUPPORT = "Targeet does not support the enclave feature.";
     public static final String NO_DOCKER_SUPPORT = "Target does not support the 'docker' property.";
     public static final String NO_DOCKER_TEST_SUPPORT = "Docker tests are only supported on Linux.";
+    public static final String NO_BENCHMARK_SUPPORT = "Target does not have benchmark tests.";
 
     /* Descriptions of collections of tests. */
     public static final String DESC_SERIALIZATION = "Run serialization tests.";
@@ -151,6 +152,7 @@ public abstract class TestBase extends LfInjectedTestBase {
     public static final String DESC_ROS2 = "Running tests using ROS2.";
     public static final String DESC_MODAL = "Run modal reactor tests.";
     public static final String DESC_VERIFIER = "Run verifier tests.";
+    public static final String DESC_BENCHMARK = "Run benchmark tests.";
   }
 
   /** Constructor for test classes that test a single target. */
@@ -340,6 +340,8 @@ public class TestRegistry {
     FLEXPRET(false, "flexpret", TestLevel.BUILD),
     PATMOS(false, "patmos", TestLevel.EXECUTION),
     VERIFIER(false, "verifier", TestLevel.EXECUTION),
+    /** Performance benchmarks that check their own timing against thresholds. */
+    BENCHMARK(false, "", TestLevel.EXECUTION),
     TARGET(false, "", TestLevel.EXECUTION);
 
     /** Whether we should compare coverage against other targets. */